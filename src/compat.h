@@ -0,0 +1,39 @@
+/*
+   libltc - en+decode linear timecode
+
+   Copyright (C) 2026 The libltc contributors
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as
+   published by the Free Software Foundation, either version 3 of the
+   License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with this library.
+   If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef LTC_COMPAT_H
+#define LTC_COMPAT_H 1
+
+#include <math.h>
+
+#if (defined _MSC_VER && _MSC_VER <= 1800)
+#define inline __inline
+#endif
+
+#if (defined _MSC_VER && _MSC_VER < 1800) || (defined __AVR__)
+static inline double ltc_rint(double v) {
+	// NB. this is identical to round(), not rint(), but the difference is not relevant here
+	return floor(v + 0.5);
+}
+#define rint(v) ltc_rint(v)
+#define lrint(v) ((long) ltc_rint(v))
+#endif
+
+#endif
@@ -81,6 +81,16 @@
 #include <math.h>
 
 #include "decoder.h"
+#include "bitreverse.h"
+#include "compat.h"
+
+#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+# include <emmintrin.h>
+# define LTC_EDGE_SCAN_SSE2
+#elif defined __ARM_NEON && defined __aarch64__
+# include <arm_neon.h>
+# define LTC_EDGE_SCAN_NEON
+#endif
 
 #define DEBUG_DUMP(msg, f) \
 { \
@@ -101,10 +111,6 @@
 	printf("\n"); \
 }
 
-#if (defined _MSC_VER && _MSC_VER <= 1800)
-#define inline __inline
-#endif
-
 #if (!defined INFINITY && defined _MSC_VER)
 #define INFINITY std::numeric_limits<double>::infinity()
 #endif
@@ -118,11 +124,117 @@ static double calc_volume_db(LTCDecoder *d) {
 	return (20.0 * log10((d->snd_to_biphase_max - d->snd_to_biphase_min) / 255.0));
 }
 
-static void parse_ltc(LTCDecoder *d, unsigned char bit, ltc_off_t offset, ltc_off_t posinfo) {
-	int bit_num, bit_set, byte_num;
+/** copy the received bits into a LTCFrame, bit 0 is the LSB of the first byte */
+static void store_frame(LTCDecoder *d, LTCFrame *frame) {
+	unsigned char *b = (unsigned char*) frame;
+	int k;
+	memset(frame, 0, sizeof(LTCFrame));
+	for (k = 0; k < 8; ++k) {
+		b[k] = (d->ltc_bits_lo >> (8 * k)) & 0xff;
+	}
+	b[8] = d->ltc_bits_hi & 0xff;
+	b[9] = (d->ltc_bits_hi >> 8) & 0xff;
+}
 
+/** copy the bits of a frame that was received in reverse into a LTCFrame.
+ * The data bits 0..63 are mirrored, the sync-word bytes are only
+ * bit-reversed in place.
+ */
+static void store_reversed_frame(LTCDecoder *d, LTCFrame *frame) {
+	unsigned char *b = (unsigned char*) frame;
+	int k;
+	memset(frame, 0, sizeof(LTCFrame));
+	for (k = 0; k < 8; ++k) {
+		b[7 - k] = bit_reverse[(d->ltc_bits_lo >> (8 * k)) & 0xff];
+	}
+	b[8] = bit_reverse[d->ltc_bits_hi & 0xff];
+	b[9] = bit_reverse[(d->ltc_bits_hi >> 8) & 0xff];
+}
+
+/** @return queue index to store the next decoded frame at, -1 if the queue is full */
+static int queue_reserve(LTCDecoder *d) {
+	const int next = (d->queue_write_off + 1) % d->queue_len;
+	if (next == LTC_LOAD_ACQUIRE(&d->queue_read_off)) {
+		if (d->flags & LTC_DECODER_SPSC) {
+			/* the reader owns queue_read_off, drop the new frame */
+			return -1;
+		}
+		/* drop the oldest frame */
+		d->queue_read_off = (next + 1) % d->queue_len;
+	}
+	return d->queue_write_off;
+}
+
+/** make the frame at queue_reserve() available to the reader */
+static void queue_commit(LTCDecoder *d) {
+	LTC_STORE_RELEASE(&d->queue_write_off, (d->queue_write_off + 1) % d->queue_len);
+}
+
+/** pass a completely received frame to the queue or the frame callback */
+static void emit_frame(LTCDecoder *d, int backwards, ltc_off_t off_start, ltc_off_t off_end, int reverse) {
+	LTCFrameExt *frame;
+
+	if (d->queue_compact && !d->frame_cb) {
+		LTCFrameCompact *cframe;
+		const int slot = queue_reserve(d);
+		if (slot < 0) {
+			return;
+		}
+		cframe = &d->queue_compact[slot];
+		if (backwards) {
+			store_reversed_frame(d, &cframe->ltc);
+		} else {
+			store_frame(d, &cframe->ltc);
+		}
+		cframe->off_start = off_start;
+		cframe->off_end = off_end;
+		cframe->reverse = reverse;
+		queue_commit(d);
+		return;
+	}
+
+	if (d->frame_cb) {
+		frame = &d->cb_frame;
+	} else {
+		const int slot = queue_reserve(d);
+		if (slot < 0) {
+			return;
+		}
+		frame = &d->queue[slot];
+	}
+
+	if (backwards) {
+		store_reversed_frame(d, &frame->ltc);
+	} else {
+		store_frame(d, &frame->ltc);
+	}
+
+	/* per-bit timing is only collected for the queue, the ring-buffer
+	 * d->biphase_tics starts at the oldest bit, d->biphase_tic */
+	if (!d->frame_cb && !(d->flags & LTC_DECODER_COMPACT)) {
+		const int n = LTC_FRAME_BIT_COUNT - d->biphase_tic;
+		memcpy(frame->biphase_tics, &d->biphase_tics[d->biphase_tic], n * sizeof(float));
+		memcpy(&frame->biphase_tics[n], d->biphase_tics, d->biphase_tic * sizeof(float));
+	}
+
+	frame->off_start = off_start;
+	frame->off_end = off_end;
+	frame->reverse = reverse;
+	frame->volume = calc_volume_db(d);
+	frame->sample_min = d->snd_to_biphase_min;
+	frame->sample_max = d->snd_to_biphase_max;
+
+	if (d->frame_cb) {
+		d->frame_cb(d, frame, d->frame_cb_arg);
+	} else {
+		queue_commit(d);
+	}
+}
+
+static void parse_ltc(LTCDecoder *d, unsigned char bit, ltc_off_t offset, ltc_off_t posinfo) {
 	if (d->bit_cnt == 0) {
-		memset(&d->ltc_frame, 0, sizeof(LTCFrame));
+		d->ltc_bits_lo = 0;
+		d->ltc_bits_hi = 0;
 
 		if (d->frame_start_prev < 0) {
 			d->frame_start_off = posinfo - d->snd_to_biphase_period;
@@ -134,24 +246,8 @@ static void parse_ltc(LTCDecoder *d, unsigned char bit, ltc_off_t offset, ltc_of
 
 	if (d->bit_cnt >= LTC_FRAME_BIT_COUNT) {
 		/* shift bits backwards */
-		int k = 0;
-		const int byte_num_max = LTC_FRAME_BIT_COUNT >> 3;
-
-		for (k=0; k< byte_num_max; k++) {
-			const unsigned char bi = ((unsigned char*)&d->ltc_frame)[k];
-			unsigned char bo = 0;
-			bo |= (bi & B8(10000000) ) ? B8(01000000) : 0;
-			bo |= (bi & B8(01000000) ) ? B8(00100000) : 0;
-			bo |= (bi & B8(00100000) ) ? B8(00010000) : 0;
-			bo |= (bi & B8(00010000) ) ? B8(00001000) : 0;
-			bo |= (bi & B8(00001000) ) ? B8(00000100) : 0;
-			bo |= (bi & B8(00000100) ) ? B8(00000010) : 0;
-			bo |= (bi & B8(00000010) ) ? B8(00000001) : 0;
-			if (k+1 < byte_num_max) {
-				bo |= ( (((unsigned char*)&d->ltc_frame)[k+1]) & B8(00000001) ) ? B8(10000000): B8(00000000);
-			}
-			((unsigned char*)&d->ltc_frame)[k] = bo;
-		}
+		d->ltc_bits_lo = (d->ltc_bits_lo >> 1) | (d->ltc_bits_hi << 63);
+		d->ltc_bits_hi >>= 1;
 
 		d->frame_start_off += ceil(d->snd_to_biphase_period);
 		d->bit_cnt--;
@@ -162,15 +258,10 @@ static void parse_ltc(LTCDecoder *d, unsigned char bit, ltc_off_t offset, ltc_of
 
 		d->decoder_sync_word |= B16(00000000,00000001);
 
-		if (d->bit_cnt < LTC_FRAME_BIT_COUNT) {
-			// Isolating the lowest three bits: the location of this bit in the current byte
-			bit_num = (d->bit_cnt & B8(00000111));
-			// Using the bit number to define which of the eight bits to set
-			bit_set = (B8(00000001) << bit_num);
-			// Isolating the higher bits: the number of the byte/char the target bit is contained in
-			byte_num = d->bit_cnt >> 3;
-
-			(((unsigned char*)&d->ltc_frame)[byte_num]) |= bit_set;
+		if (d->bit_cnt < 64) {
+			d->ltc_bits_lo |= 1ULL << d->bit_cnt;
+		} else if (d->bit_cnt < LTC_FRAME_BIT_COUNT) {
+			d->ltc_bits_hi |= 1ULL << (d->bit_cnt - 64);
 		}
 
 	}
@@ -178,30 +269,10 @@ static void parse_ltc(LTCDecoder *d, unsigned char bit, ltc_off_t offset, ltc_of
 
 	if (d->decoder_sync_word == B16(00111111,11111101) /*LTC Sync Word 0x3ffd*/) {
 		if (d->bit_cnt == LTC_FRAME_BIT_COUNT) {
-			int bc;
-
-			if (d->queue_write_off == d->queue_len) {
-				d->queue_write_off = 0;
-			}
-
-			memcpy( &d->queue[d->queue_write_off].ltc,
-				&d->ltc_frame,
-				sizeof(LTCFrame));
-
-			for(bc = 0; bc < LTC_FRAME_BIT_COUNT; ++bc) {
-				const int btc = (d->biphase_tic + bc ) % LTC_FRAME_BIT_COUNT;
-				d->queue[d->queue_write_off].biphase_tics[bc] = d->biphase_tics[btc];
-			}
-
-			d->queue[d->queue_write_off].off_start = d->frame_start_off;
-			d->queue[d->queue_write_off].off_end = posinfo + (ltc_off_t) offset - 1LL;
-			d->queue[d->queue_write_off].reverse = 0;
-			d->queue[d->queue_write_off].volume = calc_volume_db(d);
-			d->queue[d->queue_write_off].sample_min = d->snd_to_biphase_min;
-			d->queue[d->queue_write_off].sample_max = d->snd_to_biphase_max;
-
-			d->queue_write_off++;
-
+			emit_frame(d, 0,
+					d->frame_start_off,
+					posinfo + (ltc_off_t) offset - 1LL,
+					0);
 		}
 		d->bit_cnt = 0;
 	}
@@ -209,54 +280,10 @@ static void parse_ltc(LTCDecoder *d, unsigned char bit, ltc_off_t offset, ltc_of
 	if (d->decoder_sync_word == B16(10111111,11111100) /* reverse sync-word*/) {
 		if (d->bit_cnt == LTC_FRAME_BIT_COUNT) {
 			/* reverse frame */
-			int bc;
-			int k = 0;
-			int byte_num_max = LTC_FRAME_BIT_COUNT >> 3;
-
-			/* swap bits */
-			for (k=0; k< byte_num_max; k++) {
-				const unsigned char bi = ((unsigned char*)&d->ltc_frame)[k];
-				unsigned char bo = 0;
-				bo |= (bi & B8(10000000) ) ? B8(00000001) : 0;
-				bo |= (bi & B8(01000000) ) ? B8(00000010) : 0;
-				bo |= (bi & B8(00100000) ) ? B8(00000100) : 0;
-				bo |= (bi & B8(00010000) ) ? B8(00001000) : 0;
-				bo |= (bi & B8(00001000) ) ? B8(00010000) : 0;
-				bo |= (bi & B8(00000100) ) ? B8(00100000) : 0;
-				bo |= (bi & B8(00000010) ) ? B8(01000000) : 0;
-				bo |= (bi & B8(00000001) ) ? B8(10000000) : 0;
-				((unsigned char*)&d->ltc_frame)[k] = bo;
-			}
-
-			/* swap bytes */
-			byte_num_max-=2; // skip sync-word
-			for (k=0; k< (byte_num_max)/2; k++) {
-				const unsigned char bi = ((unsigned char*)&d->ltc_frame)[k];
-				((unsigned char*)&d->ltc_frame)[k] = ((unsigned char*)&d->ltc_frame)[byte_num_max-1-k];
-				((unsigned char*)&d->ltc_frame)[byte_num_max-1-k] = bi;
-			}
-
-			if (d->queue_write_off == d->queue_len) {
-				d->queue_write_off = 0;
-			}
-
-			memcpy( &d->queue[d->queue_write_off].ltc,
-				&d->ltc_frame,
-				sizeof(LTCFrame));
-
-			for(bc = 0; bc < LTC_FRAME_BIT_COUNT; ++bc) {
-				const int btc = (d->biphase_tic + bc ) % LTC_FRAME_BIT_COUNT;
-				d->queue[d->queue_write_off].biphase_tics[bc] = d->biphase_tics[btc];
-			}
-
-			d->queue[d->queue_write_off].off_start = d->frame_start_off - 16 * d->snd_to_biphase_period;
-			d->queue[d->queue_write_off].off_end = posinfo + (ltc_off_t) offset - 1LL - 16 * d->snd_to_biphase_period;
-			d->queue[d->queue_write_off].reverse = (LTC_FRAME_BIT_COUNT >> 3) * 8 * d->snd_to_biphase_period;
-			d->queue[d->queue_write_off].volume = calc_volume_db(d);
-			d->queue[d->queue_write_off].sample_min = d->snd_to_biphase_min;
-			d->queue[d->queue_write_off].sample_max = d->snd_to_biphase_max;
-
-			d->queue_write_off++;
+			emit_frame(d, 1,
+					d->frame_start_off - 16 * d->snd_to_biphase_period,
+					posinfo + (ltc_off_t) offset - 1LL - 16 * d->snd_to_biphase_period,
+					(LTC_FRAME_BIT_COUNT >> 3) * 8 * d->snd_to_biphase_period);
 		}
 		d->bit_cnt = 0;
 	}
@@ -282,67 +309,510 @@ static inline void biphase_decode2(LTCDecoder *d, ltc_off_t offset, ltc_off_t po
 	d->biphase_prev = d->snd_to_biphase_state;
 }
 
+/** number of samples checked at once by the edge pre-scan */
+#define EDGE_SCAN_LEN 16
+
+/** min/max envelope distance from SAMPLE_CENTER (0..128) after
+ * EDGE_SCAN_LEN samples without a new peak, i.e. (d * 15) / 16
+ * applied EDGE_SCAN_LEN times.
+ */
+static const unsigned char env_decay16[129] = {
+	  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+	  0,   0,   1,   1,   2,   2,   3,   3,   4,   4,   5,   5,   6,   6,   7,   7,
+	  8,   8,   8,   9,   9,   9,  10,  10,  10,  11,  11,  11,  12,  12,  12,  13,
+	 13,  13,  13,  14,  14,  14,  14,  15,  15,  15,  15,  16,  16,  16,  17,  18,
+	 18,  18,  18,  19,  20,  20,  20,  20,  21,  22,  22,  22,  22,  23,  24,  24,
+	 24,  24,  24,  25,  26,  26,  26,  26,  26,  27,  28,  28,  28,  28,  28,  29,
+	 30,  30,  30,  30,  30,  30,  31,  32,  32,  33,  33,  33,  33,  34,  35,  35,
+	 36,  36,  36,  36,  36,  37,  38,  38,  39,  39,  39,  39,  39,  40,  41,  41,
+	 42
+};
+
+/* index of the first sample > bound, or n if there is none */
+static inline size_t find_above(const ltcsnd_sample_t *s, size_t n, ltcsnd_sample_t bound) {
+	size_t i;
+#if defined LTC_EDGE_SCAN_SSE2
+	if (n == EDGE_SCAN_LEN) {
+		const __m128i v = _mm_loadu_si128((const __m128i*) s);
+		const __m128i z = _mm_subs_epu8(v, _mm_set1_epi8((char) bound));
+		if (_mm_movemask_epi8(_mm_cmpeq_epi8(z, _mm_setzero_si128())) == 0xffff) {
+			return n;
+		}
+	}
+#elif defined LTC_EDGE_SCAN_NEON
+	if (n == EDGE_SCAN_LEN) {
+		if (vmaxvq_u8(vcgtq_u8(vld1q_u8(s), vdupq_n_u8(bound))) == 0) {
+			return n;
+		}
+	}
+#endif
+	for (i = 0; i < n; ++i) {
+		if (s[i] > bound) break;
+	}
+	return i;
+}
+
+/* index of the first sample < bound, or n if there is none */
+static inline size_t find_below(const ltcsnd_sample_t *s, size_t n, ltcsnd_sample_t bound) {
+	size_t i;
+#if defined LTC_EDGE_SCAN_SSE2
+	if (n == EDGE_SCAN_LEN) {
+		const __m128i v = _mm_loadu_si128((const __m128i*) s);
+		const __m128i z = _mm_subs_epu8(_mm_set1_epi8((char) bound), v);
+		if (_mm_movemask_epi8(_mm_cmpeq_epi8(z, _mm_setzero_si128())) == 0xffff) {
+			return n;
+		}
+	}
+#elif defined LTC_EDGE_SCAN_NEON
+	if (n == EDGE_SCAN_LEN) {
+		if (vmaxvq_u8(vcltq_u8(vld1q_u8(s), vdupq_n_u8(bound))) == 0) {
+			return n;
+		}
+	}
+#endif
+	for (i = 0; i < n; ++i) {
+		if (s[i] < bound) break;
+	}
+	return i;
+}
+
+#if defined LTC_EDGE_SCAN_SSE2
+/* one envelope decay step of distances from SAMPLE_CENTER (0..128),
+ * (x * 15) / 16 == x - ceil(x / 16) */
+static inline __m128i env_decay_epu8(__m128i x) {
+	const __m128i r = _mm_srli_epi16(_mm_add_epi8(x, _mm_set1_epi8(15)), 4);
+	return _mm_sub_epi8(x, _mm_and_si128(r, _mm_set1_epi8(0x0f)));
+}
+
+/* envelope distance after EDGE_SCAN_LEN samples with the distances \p x
+ * (oldest first), starting from \p env. Same as decaying and taking the
+ * maximum one sample at a time. */
+static inline unsigned char env_track16(__m128i x, unsigned char env) {
+	const unsigned char decayed = env_decay16[env];
+	__m128i m, t;
+	int k;
+
+	m = _mm_max_epu8(x, _mm_srli_si128(x, 8));
+	m = _mm_max_epu8(m, _mm_srli_si128(m, 4));
+	m = _mm_max_epu8(m, _mm_srli_si128(m, 2));
+	m = _mm_max_epu8(m, _mm_srli_si128(m, 1));
+	if ((_mm_cvtsi128_si32(m) & 0xff) <= decayed) {
+		/* no sample rises above the decaying envelope */
+		return decayed;
+	}
+
+	/* prefix scan, lane n: envelope of samples 0..n starting from zero.
+	 * decay is monotonic, so it can be applied to the maximum */
+	x = _mm_max_epu8(x, env_decay_epu8(_mm_slli_si128(x, 1)));
+	t = env_decay_epu8(env_decay_epu8(_mm_slli_si128(x, 2)));
+	x = _mm_max_epu8(x, t);
+	t = _mm_slli_si128(x, 4);
+	for (k = 0; k < 4; ++k) {
+		t = env_decay_epu8(t);
+	}
+	x = _mm_max_epu8(x, t);
+	t = _mm_slli_si128(x, 8);
+	for (k = 0; k < 8; ++k) {
+		t = env_decay_epu8(t);
+	}
+	x = _mm_max_epu8(x, t);
+
+	k = _mm_cvtsi128_si32(_mm_srli_si128(x, 15)) & 0xff;
+	return k > decayed ? k : decayed;
+}
+#endif
+
+/** Skip samples which can not trigger a biphase state change.
+ *
+ * Within EDGE_SCAN_LEN samples the min/max envelope decays at most to
+ * env_decay16[], which gives a lower bound for max_threshold
+ * (and an upper bound for min_threshold) that holds for the whole block.
+ * Samples on the inner side of that bound only need envelope tracking,
+ * which is done for a whole block at once with SSE2, see env_track16().
+ *
+ * @return number of samples consumed. The next sample (if any) is a
+ * candidate for a state change and needs to be checked by the caller.
+ */
+static size_t skip_to_edge(LTCDecoder *d, const ltcsnd_sample_t *sound, size_t size) {
+	size_t i = 0;
+
+	while (i < size) {
+		const size_t n = (size - i > EDGE_SCAN_LEN) ? EDGE_SCAN_LEN : size - i;
+		size_t k, c;
+
+		if (d->snd_to_biphase_state) {
+			const ltcsnd_sample_t bound = SAMPLE_CENTER + ((env_decay16[d->snd_to_biphase_max - SAMPLE_CENTER] * 8) / 16);
+			c = find_above(&sound[i], n, bound);
+		} else {
+			const ltcsnd_sample_t bound = SAMPLE_CENTER - ((env_decay16[SAMPLE_CENTER - d->snd_to_biphase_min] * 8) / 16);
+			c = find_below(&sound[i], n, bound);
+		}
+
+		/* track minimum and maximum values */
+#if defined LTC_EDGE_SCAN_SSE2
+		if (c == EDGE_SCAN_LEN) {
+			const __m128i v = _mm_loadu_si128((const __m128i*) &sound[i]);
+			const __m128i center = _mm_set1_epi8((char) SAMPLE_CENTER);
+			d->snd_to_biphase_min = SAMPLE_CENTER - env_track16(_mm_subs_epu8(center, v), SAMPLE_CENTER - d->snd_to_biphase_min);
+			d->snd_to_biphase_max = SAMPLE_CENTER + env_track16(_mm_subs_epu8(v, center), d->snd_to_biphase_max - SAMPLE_CENTER);
+		} else
+#endif
+		for (k = i; k < i + c; ++k) {
+			d->snd_to_biphase_min = SAMPLE_CENTER - (((SAMPLE_CENTER - d->snd_to_biphase_min) * 15) / 16);
+			d->snd_to_biphase_max = SAMPLE_CENTER + (((d->snd_to_biphase_max - SAMPLE_CENTER) * 15) / 16);
+
+			if (sound[k] < d->snd_to_biphase_min)
+				d->snd_to_biphase_min = sound[k];
+			if (sound[k] > d->snd_to_biphase_max)
+				d->snd_to_biphase_max = sound[k];
+		}
+
+		d->snd_to_biphase_cnt += c;
+		i += c;
+
+		if (c < n) {
+			break;
+		}
+	}
+	return i;
+}
+
+/** a biphase state change was detected at sample \p offset */
+static inline void biphase_state_change(LTCDecoder *d, size_t offset, ltc_off_t posinfo) {
+	/* If the sample count has risen above the biphase length limit */
+	if (d->snd_to_biphase_cnt > d->snd_to_biphase_lmt) {
+		/* single state change within a biphase priod. decode to a 0 */
+		biphase_decode2(d, offset, posinfo);
+		biphase_decode2(d, offset, posinfo);
+
+	} else {
+		/* "short" state change covering half a period
+		 * together with the next or previous state change decode to a 1
+		 */
+		d->snd_to_biphase_cnt *= 2;
+		biphase_decode2(d, offset, posinfo);
+
+	}
+
+	if (d->snd_to_biphase_cnt > (d->snd_to_biphase_period * 4)) {
+		/* "long" silence in between
+		 * -> reset parser, don't use it for phase-tracking
+		 */
+		d->bit_cnt = 0;
+	} else  {
+		/* track speed variations
+		 * As this is only executed at a state change,
+		 * d->snd_to_biphase_cnt is an accurate representation of the current period length.
+		 */
+		d->snd_to_biphase_period = (d->snd_to_biphase_period * 3.0 + d->snd_to_biphase_cnt) / 4.0;
+
+		/* This limit specifies when a state-change is
+		 * considered biphase-clock or 2*biphase-clock.
+		 * The relation with period has been determined
+		 * empirically through trial-and-error */
+		d->snd_to_biphase_lmt = (d->snd_to_biphase_period * 3) / 4;
+	}
+
+	d->snd_to_biphase_cnt = 0;
+	d->snd_to_biphase_state = !d->snd_to_biphase_state;
+}
+
+static inline void decode_ltc_sample(LTCDecoder *d, const ltcsnd_sample_t s, size_t offset, ltc_off_t posinfo) {
+	ltcsnd_sample_t max_threshold, min_threshold;
+
+	/* track minimum and maximum values */
+	d->snd_to_biphase_min = SAMPLE_CENTER - (((SAMPLE_CENTER - d->snd_to_biphase_min) * 15) / 16);
+	d->snd_to_biphase_max = SAMPLE_CENTER + (((d->snd_to_biphase_max - SAMPLE_CENTER) * 15) / 16);
+
+	if (s < d->snd_to_biphase_min)
+		d->snd_to_biphase_min = s;
+	if (s > d->snd_to_biphase_max)
+		d->snd_to_biphase_max = s;
+
+	/* set the thresholds for hi/lo state tracking */
+	min_threshold = SAMPLE_CENTER - (((SAMPLE_CENTER - d->snd_to_biphase_min) * 8) / 16);
+	max_threshold = SAMPLE_CENTER + (((d->snd_to_biphase_max - SAMPLE_CENTER) * 8) / 16);
+
+	if ( /* Check for a biphase state change */
+		   (  d->snd_to_biphase_state && (s > max_threshold) )
+		|| ( !d->snd_to_biphase_state && (s < min_threshold) )
+	   ) {
+		biphase_state_change(d, offset, posinfo);
+	}
+	d->snd_to_biphase_cnt++;
+}
+
 void decode_ltc(LTCDecoder *d, ltcsnd_sample_t *sound, size_t size, ltc_off_t posinfo) {
+	size_t i = 0;
+
+	while (i < size) {
+		i += skip_to_edge(d, &sound[i], size - i);
+		if (i == size) {
+			break;
+		}
+		decode_ltc_sample(d, sound[i], i, posinfo);
+		i++;
+	}
+}
+
+void decode_ltc_strided(LTCDecoder *d, ltcsnd_sample_t *sound, size_t size, size_t stride, ltc_off_t posinfo) {
 	size_t i;
 
+	if (stride == 1) {
+		decode_ltc(d, sound, size, posinfo);
+		return;
+	}
+
 	for (i = 0 ; i < size ; i++) {
-		ltcsnd_sample_t max_threshold, min_threshold;
+		decode_ltc_sample(d, sound[i * stride], i, posinfo);
+	}
+}
 
-		/* track minimum and maximum values */
-		d->snd_to_biphase_min = SAMPLE_CENTER - (((SAMPLE_CENTER - d->snd_to_biphase_min) * 15) / 16);
-		d->snd_to_biphase_max = SAMPLE_CENTER + (((d->snd_to_biphase_max - SAMPLE_CENTER) * 15) / 16);
-
-		if (sound[i] < d->snd_to_biphase_min)
-			d->snd_to_biphase_min = sound[i];
-		if (sound[i] > d->snd_to_biphase_max)
-			d->snd_to_biphase_max = sound[i];
-
-		/* set the thresholds for hi/lo state tracking */
-		min_threshold = SAMPLE_CENTER - (((SAMPLE_CENTER - d->snd_to_biphase_min) * 8) / 16);
-		max_threshold = SAMPLE_CENTER + (((d->snd_to_biphase_max - SAMPLE_CENTER) * 8) / 16);
-
-		if ( /* Check for a biphase state change */
-			   (  d->snd_to_biphase_state && (sound[i] > max_threshold) )
-			|| ( !d->snd_to_biphase_state && (sound[i] < min_threshold) )
-		   ) {
-
-			/* If the sample count has risen above the biphase length limit */
-			if (d->snd_to_biphase_cnt > d->snd_to_biphase_lmt) {
-				/* single state change within a biphase priod. decode to a 0 */
-				biphase_decode2(d, i, posinfo);
-				biphase_decode2(d, i, posinfo);
-
-			} else {
-				/* "short" state change covering half a period
-				 * together with the next or previous state change decode to a 1
-				 */
-				d->snd_to_biphase_cnt *= 2;
-				biphase_decode2(d, i, posinfo);
+/* -+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+ * Native decoders for non 8-bit audio
+ *
+ * The envelope and thresholds are tracked in the float domain
+ * (-1..+1, 0 = center), samples are read directly from the
+ * caller's buffer.
+ */
 
-			}
+static inline ltcsnd_sample_t float_to_sample(float v) {
+	if (v < -1.f) v = -1.f;
+	if (v > 1.f) v = 1.f;
+	return (ltcsnd_sample_t) (SAMPLE_CENTER + v * 127.f);
+}
 
-			if (d->snd_to_biphase_cnt > (d->snd_to_biphase_period * 4)) {
-				/* "long" silence in between
-				 * -> reset parser, don't use it for phase-tracking
-				 */
-				d->bit_cnt = 0;
-			} else  {
-				/* track speed variations
-				 * As this is only executed at a state change,
-				 * d->snd_to_biphase_cnt is an accurate representation of the current period length.
-				 */
-				d->snd_to_biphase_period = (d->snd_to_biphase_period * 3.0 + d->snd_to_biphase_cnt) / 4.0;
-
-				/* This limit specifies when a state-change is
-				 * considered biphase-clock or 2*biphase-clock.
-				 * The relation with period has been determined
-				 * empirically through trial-and-error */
-				d->snd_to_biphase_lmt = (d->snd_to_biphase_period * 3) / 4;
-			}
+static inline void decode_ltc_sample_f(LTCDecoder *d, const float s, size_t offset, ltc_off_t posinfo) {
+	/* track minimum and maximum values */
+	d->snd_to_biphase_min_f *= (15.f / 16.f);
+	d->snd_to_biphase_max_f *= (15.f / 16.f);
+
+	if (s < d->snd_to_biphase_min_f)
+		d->snd_to_biphase_min_f = s;
+	if (s > d->snd_to_biphase_max_f)
+		d->snd_to_biphase_max_f = s;
+
+	if ( /* Check for a biphase state change, threshold at 50% of the envelope */
+			(  d->snd_to_biphase_state && (s > .5f * d->snd_to_biphase_max_f) )
+			|| ( !d->snd_to_biphase_state && (s < .5f * d->snd_to_biphase_min_f) )
+		 ) {
+		/* LTCFrameExt reports 8-bit min/max */
+		d->snd_to_biphase_min = float_to_sample(d->snd_to_biphase_min_f);
+		d->snd_to_biphase_max = float_to_sample(d->snd_to_biphase_max_f);
+		biphase_state_change(d, offset, posinfo);
+	}
+	d->snd_to_biphase_cnt++;
+}
+
+#define D1 (15.f / 16.f)
+#define D2 (D1 * D1)
+#define D4 (D2 * D2)
+#define D8 (D4 * D4)
+
+/** envelope decay after n samples, (15/16)^n */
+static const float env_decay_f[EDGE_SCAN_LEN + 1] = {
+	1.f, D1, D2, D2 * D1, D4, D4 * D1, D4 * D2, D4 * D2 * D1,
+	D8, D8 * D1, D8 * D2, D8 * D2 * D1, D8 * D4, D8 * D4 * D1, D8 * D4 * D2, D8 * D4 * D2 * D1,
+	D8 * D8
+};
+
+#undef D1
+#undef D2
+#undef D4
+#undef D8
+
+/** Float version of skip_to_edge() for up to EDGE_SCAN_LEN samples.
+ *
+ * Samples before the first one that exceeds half the envelope, decayed
+ * over all \p n samples, can not trigger a state change. On that side
+ * they can not reach the envelope either, which only decays. The other
+ * side takes the maximum of each sample decayed to the end of the run.
+ *
+ * @return number of samples consumed
+ */
+static size_t skip_to_edge_f(LTCDecoder *d, const float *s, size_t n) {
+	size_t c, k;
+
+	if (d->snd_to_biphase_state) {
+		const float bound = .5f * d->snd_to_biphase_max_f * env_decay_f[n];
+		float min = 0;
+		for (c = 0; c < n; ++c) {
+			if (s[c] > bound) break;
+		}
+		for (k = 0; k < c; ++k) {
+			const float v = s[k] * env_decay_f[c - 1 - k];
+			min = v < min ? v : min;
+		}
+		d->snd_to_biphase_max_f *= env_decay_f[c];
+		d->snd_to_biphase_min_f *= env_decay_f[c];
+		if (min < d->snd_to_biphase_min_f)
+			d->snd_to_biphase_min_f = min;
+	} else {
+		const float bound = .5f * d->snd_to_biphase_min_f * env_decay_f[n];
+		float max = 0;
+		for (c = 0; c < n; ++c) {
+			if (s[c] < bound) break;
+		}
+		for (k = 0; k < c; ++k) {
+			const float v = s[k] * env_decay_f[c - 1 - k];
+			max = v > max ? v : max;
+		}
+		d->snd_to_biphase_min_f *= env_decay_f[c];
+		d->snd_to_biphase_max_f *= env_decay_f[c];
+		if (max > d->snd_to_biphase_max_f)
+			d->snd_to_biphase_max_f = max;
+	}
+
+	/* flush to zero after silence, decaying further runs into denormals */
+	if (d->snd_to_biphase_min_f > -1e-20f)
+		d->snd_to_biphase_min_f = 0;
+	if (d->snd_to_biphase_max_f < 1e-20f)
+		d->snd_to_biphase_max_f = 0;
+
+	d->snd_to_biphase_cnt += c;
+	return c;
+}
+
+/* samples are converted in blocks of EDGE_SCAN_LEN, only candidates
+ * for a state change are decoded one at a time */
+#define DECODE_LTC_TEMPLATE(FN, FORMAT, CONV) \
+void decode_ltc_ ## FN (LTCDecoder *d, FORMAT *sound, size_t size, size_t stride, ltc_off_t posinfo) { \
+	float buf[EDGE_SCAN_LEN]; \
+	size_t i, j; \
+	for (i = 0 ; i < size ; i += EDGE_SCAN_LEN) { \
+		const size_t n = (size - i > EDGE_SCAN_LEN) ? EDGE_SCAN_LEN : size - i; \
+		for (j = 0; j < n; ++j) { \
+			const FORMAT s = sound[(i + j) * stride]; \
+			buf[j] = CONV; \
+		} \
+		for (j = 0; j < n; ++j) { \
+			j += skip_to_edge_f(d, &buf[j], n - j); \
+			if (j < n) { \
+				decode_ltc_sample_f(d, buf[j], i + j, posinfo); \
+			} \
+		} \
+	} \
+}
+
+DECODE_LTC_TEMPLATE(float, float, s)
+DECODE_LTC_TEMPLATE(double, double, (float) s)
+DECODE_LTC_TEMPLATE(s16, short, s * (1.f / 32768.f))
+DECODE_LTC_TEMPLATE(u16, unsigned short, (s - 32768) * (1.f / 32768.f))
+
+#undef DECODE_LTC_TEMPLATE
+
+/* -+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+ * Decoder bank
+ *
+ * Per-sample state of all channels is kept in struct-of-arrays form
+ * and all channels are advanced together, one audio-frame at a time.
+ * When a channel sees a biphase state change, the state is handed to
+ * the channel's LTCDecoder which parses the bit and queues frames.
+ */
+
+static void bank_state_change(LTCDecoderBank *b, int c, size_t offset, ltc_off_t posinfo) {
+	LTCDecoder *d = b->decoder[c];
+	d->snd_to_biphase_min = b->snd_to_biphase_min[c];
+	d->snd_to_biphase_max = b->snd_to_biphase_max[c];
+	d->snd_to_biphase_cnt = b->snd_to_biphase_cnt[c];
+	d->snd_to_biphase_state = b->snd_to_biphase_state[c];
+
+	biphase_state_change(d, offset, posinfo);
 
-			d->snd_to_biphase_cnt = 0;
-			d->snd_to_biphase_state = !d->snd_to_biphase_state;
+	b->snd_to_biphase_cnt[c] = d->snd_to_biphase_cnt;
+	b->snd_to_biphase_state[c] = d->snd_to_biphase_state;
+}
+
+static inline int bank_sample(LTCDecoderBank *b, int c, const ltcsnd_sample_t s) {
+	ltcsnd_sample_t min = SAMPLE_CENTER - (((SAMPLE_CENTER - b->snd_to_biphase_min[c]) * 15) / 16);
+	ltcsnd_sample_t max = SAMPLE_CENTER + (((b->snd_to_biphase_max[c] - SAMPLE_CENTER) * 15) / 16);
+
+	if (s < min) min = s;
+	if (s > max) max = s;
+
+	b->snd_to_biphase_min[c] = min;
+	b->snd_to_biphase_max[c] = max;
+
+	if (b->snd_to_biphase_state[c]) {
+		return s > SAMPLE_CENTER + (((max - SAMPLE_CENTER) * 8) / 16);
+	} else {
+		return s < SAMPLE_CENTER - (((SAMPLE_CENTER - min) * 8) / 16);
+	}
+}
+
+#ifdef LTC_EDGE_SCAN_SSE2
+/* (d * 15) / 16 for 16bit lanes */
+static inline __m128i decay_epi16(__m128i d) {
+	return _mm_srli_epi16(_mm_sub_epi16(_mm_slli_epi16(d, 4), d), 4);
+}
+
+/** process 16 channels starting at \p c, @return bitmask of channels with a state change */
+static inline int bank_sample16(LTCDecoderBank *b, int c, const ltcsnd_sample_t *in) {
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i center = _mm_set1_epi16(SAMPLE_CENTER);
+	const __m128i s = _mm_loadu_si128((const __m128i*) in);
+	__m128i dl, dh, min, max, lo, hi, edge_hi, edge_lo, state;
+
+	/* min = SAMPLE_CENTER - ((SAMPLE_CENTER - min) * 15) / 16 */
+	min = _mm_loadu_si128((const __m128i*) &b->snd_to_biphase_min[c]);
+	dl = decay_epi16(_mm_sub_epi16(center, _mm_unpacklo_epi8(min, zero)));
+	dh = decay_epi16(_mm_sub_epi16(center, _mm_unpackhi_epi8(min, zero)));
+	min = _mm_packus_epi16(_mm_sub_epi16(center, dl), _mm_sub_epi16(center, dh));
+	min = _mm_min_epu8(min, s);
+
+	/* max = SAMPLE_CENTER + ((max - SAMPLE_CENTER) * 15) / 16 */
+	max = _mm_loadu_si128((const __m128i*) &b->snd_to_biphase_max[c]);
+	dl = decay_epi16(_mm_sub_epi16(_mm_unpacklo_epi8(max, zero), center));
+	dh = decay_epi16(_mm_sub_epi16(_mm_unpackhi_epi8(max, zero), center));
+	max = _mm_packus_epi16(_mm_add_epi16(center, dl), _mm_add_epi16(center, dh));
+	max = _mm_max_epu8(max, s);
+
+	_mm_storeu_si128((__m128i*) &b->snd_to_biphase_min[c], min);
+	_mm_storeu_si128((__m128i*) &b->snd_to_biphase_max[c], max);
+
+	/* thresholds at 50% of the envelope */
+	dl = _mm_srli_epi16(_mm_sub_epi16(center, _mm_unpacklo_epi8(min, zero)), 1);
+	dh = _mm_srli_epi16(_mm_sub_epi16(center, _mm_unpackhi_epi8(min, zero)), 1);
+	lo = _mm_packus_epi16(_mm_sub_epi16(center, dl), _mm_sub_epi16(center, dh));
+	dl = _mm_srli_epi16(_mm_sub_epi16(_mm_unpacklo_epi8(max, zero), center), 1);
+	dh = _mm_srli_epi16(_mm_sub_epi16(_mm_unpackhi_epi8(max, zero), center), 1);
+	hi = _mm_packus_epi16(_mm_add_epi16(center, dl), _mm_add_epi16(center, dh));
+
+	/* lanes are 0xff where s <= hi, and where s >= lo respectively */
+	edge_hi = _mm_cmpeq_epi8(_mm_subs_epu8(s, hi), zero);
+	edge_lo = _mm_cmpeq_epi8(_mm_subs_epu8(lo, s), zero);
+	/* 0xff where state is 0 */
+	state = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*) &b->snd_to_biphase_state[c]), zero);
+
+	return 0xffff & ~_mm_movemask_epi8(_mm_or_si128(_mm_andnot_si128(state, edge_hi), _mm_and_si128(state, edge_lo)));
+}
+#endif
+
+void decode_ltc_bank(LTCDecoderBank *b, ltcsnd_sample_t *sound, size_t size, ltc_off_t posinfo) {
+	const int n_channels = b->n_channels;
+	size_t i;
+
+	for (i = 0 ; i < size ; i++) {
+		const ltcsnd_sample_t *in = &sound[i * n_channels];
+		int c = 0;
+#ifdef LTC_EDGE_SCAN_SSE2
+		for (; c + 16 <= n_channels; c += 16) {
+			int k;
+			int edges = bank_sample16(b, c, &in[c]);
+			for (k = 0; edges; ++k, edges >>= 1) {
+				if (edges & 1) {
+					bank_state_change(b, c + k, i, posinfo);
+				}
+			}
+		}
+#endif
+		for (; c < n_channels; ++c) {
+			if (bank_sample(b, c, in[c])) {
+				bank_state_change(b, c, i, posinfo);
+			}
+		}
+		for (c = 0; c < n_channels; ++c) {
+			b->snd_to_biphase_cnt[c]++;
 		}
-		d->snd_to_biphase_cnt++;
 	}
 }
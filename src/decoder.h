@@ -23,11 +23,44 @@
 #define SAMPLE_CENTER 128 // unsigned 8 bit.
 #endif
 
+/* The queue offsets are shared between the thread calling ltc_decoder_write()
+ * and the thread calling ltc_decoder_read(). Each thread only modifies
+ * its own offset and publishes it with release semantics.
+ */
+#if defined __GNUC__ || defined __clang__
+typedef int ltc_atomic_int;
+# define LTC_LOAD_ACQUIRE(ptr) __atomic_load_n((ptr), __ATOMIC_ACQUIRE)
+# define LTC_STORE_RELEASE(ptr, val) __atomic_store_n((ptr), (val), __ATOMIC_RELEASE)
+#elif defined __STDC_VERSION__ && __STDC_VERSION__ >= 201112L && !defined __STDC_NO_ATOMICS__
+# include <stdatomic.h>
+typedef atomic_int ltc_atomic_int;
+# define LTC_LOAD_ACQUIRE(ptr) atomic_load_explicit((ptr), memory_order_acquire)
+# define LTC_STORE_RELEASE(ptr, val) atomic_store_explicit((ptr), (val), memory_order_release)
+#elif defined _MSC_VER
+# include <intrin.h>
+typedef volatile long ltc_atomic_int;
+/* full barriers, independent of /volatile:ms and valid on x86, x64 and ARM64 */
+# define LTC_LOAD_ACQUIRE(ptr) ((int) _InterlockedCompareExchange((ptr), 0, 0))
+# define LTC_STORE_RELEASE(ptr, val) ((void) _InterlockedExchange((ptr), (val)))
+#else
+/* no atomic operations: LTC_DECODER_SPSC is not available */
+# define LTC_NO_ATOMICS
+typedef int ltc_atomic_int;
+# define LTC_LOAD_ACQUIRE(ptr) (*(ptr))
+# define LTC_STORE_RELEASE(ptr, val) (*(ptr) = (val))
+#endif
+
 struct LTCDecoder {
 	LTCFrameExt* queue;
-	int queue_len;
-	int queue_read_off;
-	int queue_write_off;
+	LTCFrameCompact* queue_compact; ///< used instead of queue with LTC_DECODER_COMPACT
+	int queue_len; ///< allocated queue entries, one more than the usable queue size
+	ltc_atomic_int queue_read_off;
+	ltc_atomic_int queue_write_off;
+	int flags; ///< see \ref LTC_DECODER_FLAGS
+
+	ltc_decoder_frame_callback frame_cb; ///< if set, frames are passed to this callback instead of being queued
+	void *frame_cb_arg;
+	LTCFrameExt cb_frame; ///< frame passed to frame_cb
 
 	unsigned char biphase_state;
 	unsigned char biphase_prev;
@@ -39,8 +72,12 @@ struct LTCDecoder {
 	ltcsnd_sample_t snd_to_biphase_min;
 	ltcsnd_sample_t snd_to_biphase_max;
 
+	float snd_to_biphase_min_f; ///< envelope of float/s16 input -1..0
+	float snd_to_biphase_max_f; ///< envelope of float/s16 input 0..+1
+
 	unsigned short decoder_sync_word;
-	LTCFrame ltc_frame;
+	unsigned long long ltc_bits_lo; ///< bits 0..63 of the frame being received
+	unsigned long long ltc_bits_hi; ///< bits 64..79 of the frame being received
 	int bit_cnt;
 
 	ltc_off_t frame_start_off;
@@ -50,5 +87,21 @@ struct LTCDecoder {
 	int biphase_tic;
 };
 
+struct LTCDecoderBank {
+	int n_channels;
+	LTCDecoder **decoder; ///< per channel bit parser and frame queue
+
+	/* per sample state, one element per channel */
+	ltcsnd_sample_t *snd_to_biphase_min;
+	ltcsnd_sample_t *snd_to_biphase_max;
+	int *snd_to_biphase_cnt;
+	unsigned char *snd_to_biphase_state;
+};
 
 void decode_ltc(LTCDecoder *d, ltcsnd_sample_t *sound, size_t size, ltc_off_t posinfo);
+void decode_ltc_strided(LTCDecoder *d, ltcsnd_sample_t *sound, size_t size, size_t stride, ltc_off_t posinfo);
+void decode_ltc_double(LTCDecoder *d, double *sound, size_t size, size_t stride, ltc_off_t posinfo);
+void decode_ltc_float(LTCDecoder *d, float *sound, size_t size, size_t stride, ltc_off_t posinfo);
+void decode_ltc_s16(LTCDecoder *d, short *sound, size_t size, size_t stride, ltc_off_t posinfo);
+void decode_ltc_u16(LTCDecoder *d, unsigned short *sound, size_t size, size_t stride, ltc_off_t posinfo);
+void decode_ltc_bank(LTCDecoderBank *b, ltcsnd_sample_t *sound, size_t size, ltc_off_t posinfo);
@@ -24,13 +24,262 @@
 #include <math.h>
 
 #include "encoder.h"
+#include "bitreverse.h"
+#include "compat.h"
+
+size_t encode_sample_size(enum LTC_SAMPLE_FORMAT format) {
+	switch (format) {
+		case LTC_SAMPLE_S16:
+			return sizeof(short);
+		case LTC_SAMPLE_S32:
+			return sizeof(int);
+		case LTC_SAMPLE_FLOAT:
+			return sizeof(float);
+		default:
+			return sizeof(ltcsnd_sample_t);
+	}
+}
+
+/**
+ * convert a signal value -1..+1 to the encoder's sample format
+ */
+static void store_sample(LTCEncoder *e, unsigned char *dst, double v) {
+	switch (e->format) {
+		case LTC_SAMPLE_S16:
+			*(short*)dst = (short) lrint(v * 32767.0);
+			break;
+		case LTC_SAMPLE_S32:
+			*(int*)dst = (int) lrint(v * 2147483647.0);
+			break;
+		case LTC_SAMPLE_FLOAT:
+			*(float*)dst = (float) v;
+			break;
+		default:
+			*dst = (ltcsnd_sample_t) v;
+			break;
+	}
+}
+
+/**
+ * fill n samples with the given sample value
+ */
+static void fill(unsigned char *dst, const unsigned char *val, size_t sample_size, int n) {
+	int i;
+	switch (sample_size) {
+		case 1:
+			memset(dst, *val, n);
+			break;
+		case 2:
+			{
+				short v;
+				memcpy(&v, val, sizeof(short));
+				for (i = 0; i < n; ++i) {
+					((short*)dst)[i] = v;
+				}
+			}
+			break;
+		default:
+			{
+				int v;
+				memcpy(&v, val, sizeof(int));
+				for (i = 0; i < n; ++i) {
+					((int*)dst)[i] = v;
+				}
+			}
+			break;
+	}
+}
+
+/**
+ * filter an edge of the given state, store the ramp if \p ramp is not NULL.
+ * Sets level, settled and last of \p edge.
+ * @return number of ramp samples
+ */
+static int edge_ramp(LTCEncoder *e, int state, struct LTCEncoderEdge *edge, unsigned char *ramp) {
+	const double tcf = e->filter_const;
+	const size_t ss = e->sample_size;
+	int i;
+
+	edge->settled = 0;
+
+	if (e->format == LTC_SAMPLE_U8) {
+		const ltcsnd_sample_t tgtval = state ? e->enc_hi : e->enc_lo;
+		ltcsnd_sample_t val = SAMPLE_CENTER;
+
+		edge->level[0] = tgtval;
+		edge->last = val;
+		for (i = 0; i < ENCODER_EDGE_LEN; ++i) {
+			const ltcsnd_sample_t prev = val;
+			val = val + tcf * (tgtval - val);
+			if (i > 0 && val == prev) {
+				edge->settled = 1;
+				break;
+			}
+			if (ramp) ramp[i] = val;
+			edge->last = val;
+		}
+	} else {
+		const double tgtval = state ? e->volume : -e->volume;
+		double val = 0;
+		unsigned char smpl[ENCODER_MAX_SAMPLE_SIZE];
+
+		store_sample(e, edge->level, tgtval);
+		edge->last = val;
+		for (i = 0; i < ENCODER_EDGE_LEN; ++i) {
+			val = val + tcf * (tgtval - val);
+			store_sample(e, smpl, val);
+			if (ramp) memcpy(&ramp[i * ss], smpl, ss);
+			edge->last = val;
+			if (!memcmp(smpl, edge->level, ss)) {
+				/* the filter converges monotonically */
+				edge->settled = 1;
+				++i;
+				break;
+			}
+		}
+	}
+	return i;
+}
+
+/**
+ * Precompute the low-pass filtered half-bit shape for both signal states.
+ * Needs to be called whenever filter_const, the volume or the sample format
+ * changes.
+ *
+ * LTC signal should have a rise time of 40 us +/- 10 us.
+ *
+ * rise-time means from <10% to >90% of the signal.
+ * in each call to addvalues() we start at 50%, so
+ * here we need half-of it. (0.000020 sec)
+ *
+ * e->cutoff = 1.0 -exp( -1.0 / (sample_rate * .000020 / exp(1.0)) );
+ *
+ * The filter output only depends on the previous value, so once
+ * the output sample no longer changes the remaining samples are constant.
+ *
+ * 8 bit output is filtered at 8 bit resolution, all other formats
+ * at full resolution around a center of 0.
+ */
+void encode_prepare_edges(LTCEncoder *e) {
+	const size_t ss = e->sample_size;
+	int state;
+
+	for (state = 0; state < 2; ++state) {
+		struct LTCEncoderEdge *edge = &e->edge[state];
+		/* square waves only use edge->level */
+		const int len = e->filter_const > 0 ? edge_ramp(e, state, edge, NULL) : 0;
+		unsigned char *ramp = NULL;
+		int i;
+
+		if (len > 0) {
+			ramp = (unsigned char*) realloc(edge->ramp, 2 * len * ss);
+		}
+		if (!ramp) {
+			/* no filter, or out of memory: complete_edge() computes all samples */
+			free(edge->ramp);
+			edge->ramp = edge->tail = NULL;
+			edge->len = 0;
+			edge_ramp(e, state, edge, NULL);
+			edge->settled = 0;
+			edge->last = e->format == LTC_SAMPLE_U8 ? SAMPLE_CENTER : 0;
+			continue;
+		}
+
+		edge->ramp = ramp;
+		edge->tail = ramp + len * ss;
+		edge->len = edge_ramp(e, state, edge, ramp);
+		for (i = 0; i < len; ++i) {
+			memcpy(&edge->tail[(len - 1 - i) * ss], &ramp[i * ss], ss);
+		}
+	}
+	encode_cache_invalidate(e);
+}
+
+/**
+ * continue the filter beyond the precomputed edge: samples k..m-1 and
+ * their mirror image of a half-bit of n samples. Only samples
+ * from..to-1 are written, dst points to sample 'from'.
+ */
+static void complete_edge(LTCEncoder *e, unsigned char *dst, int k, int m, int n, int from, int to) {
+	const struct LTCEncoderEdge *edge = &e->edge[e->state ? 1 : 0];
+	const double tcf = e->filter_const;
+	const size_t ss = e->sample_size;
+	unsigned char * const wave = dst - from * ss;
+	unsigned char smpl[ENCODER_MAX_SAMPLE_SIZE];
+	int i;
+
+	if (e->format == LTC_SAMPLE_U8) {
+		const ltcsnd_sample_t tgtval = e->state ? e->enc_hi : e->enc_lo;
+		ltcsnd_sample_t val = edge->last;
+		for (i = k ; i < m ; i++) {
+			val = val + tcf * (tgtval - val);
+			if (i >= from && i < to) wave[i] = val;
+			if (n-i-1 >= from && n-i-1 < to) wave[n-i-1] = val;
+		}
+	} else {
+		const double tgtval = e->state ? e->volume : -e->volume;
+		double val = edge->last;
+		for (i = k ; i < m ; i++) {
+			val = val + tcf * (tgtval - val);
+			store_sample(e, smpl, val);
+			if (i >= from && i < to) memcpy(&wave[i * ss], smpl, ss);
+			if (n-i-1 >= from && n-i-1 < to) memcpy(&wave[(n-i-1) * ss], smpl, ss);
+		}
+	}
+}
+
+/**
+ * Write samples from..from+count-1 of a half-bit of n samples
+ * in the current signal state to dst.
+ */
+static void halfbit(LTCEncoder *e, unsigned char *dst, int n, int from, int count) {
+	const struct LTCEncoderEdge *edge = &e->edge[e->state ? 1 : 0];
+	const size_t ss = e->sample_size;
+	const int to = from + count;
+
+	if (e->filter_const > 0) {
+		/* low-pass-filter, the half-bit is assembled from the
+		 * precomputed edge: ramp, constant part and mirrored ramp.
+		 */
+		const int m = (n+1)>>1;
+		const int k = m < edge->len ? m : edge->len;
+		int i0, i1;
+
+		/* ramp */
+		i0 = from;
+		i1 = to < k ? to : k;
+		if (i1 > i0) {
+			memcpy(dst, &edge->ramp[i0 * ss], (i1 - i0) * ss);
+		}
+
+		/* mirrored ramp: sample i equals ramp[n-1-i] */
+		i0 = n - k > k ? n - k : k;
+		i0 = from > i0 ? from : i0;
+		i1 = to;
+		if (i1 > i0) {
+			memcpy(&dst[(i0 - from) * ss], &edge->tail[(edge->len - n + i0) * ss], (i1 - i0) * ss);
+		}
+
+		/* constant or slowly settling part */
+		i0 = from > k ? from : k;
+		i1 = to < n - k ? to : n - k;
+		if (i1 > i0) {
+			if (edge->settled) {
+				fill(&dst[(i0 - from) * ss], &edge->ramp[(k-1) * ss], ss, i1 - i0);
+			} else {
+				complete_edge(e, dst, k, m, n, from, to);
+			}
+		}
+	} else {
+		/* perfect square wave */
+		fill(dst, edge->level, ss, count);
+	}
+}
 
 /**
  * add values to the output buffer
  */
 static int addvalues(LTCEncoder *e, int n) {
-	const ltcsnd_sample_t tgtval = e->state ? e->enc_hi : e->enc_lo;
-
 	if (e->offset + n >= e->bufsize) {
 #if 0
 		fprintf(stderr, "libltc: buffer overflow: %d/%lu\n", (int) e->offset, (unsigned long) e->bufsize);
@@ -38,72 +287,318 @@ static int addvalues(LTCEncoder *e, int n) {
 		return 1;
 	}
 
-	ltcsnd_sample_t * const wave = &(e->buf[e->offset]);
-	const double tcf =  e->filter_const;
-	if (tcf > 0) {
-		/* low-pass-filter
-		 * LTC signal should have a rise time of 40 us +/- 10 us.
-		 *
-		 * rise-time means from <10% to >90% of the signal.
-		 * in each call to addvalues() we start at 50%, so
-		 * here we need half-of it. (0.000020 sec)
-		 *
-		 * e->cutoff = 1.0 -exp( -1.0 / (sample_rate * .000020 / exp(1.0)) );
-		 */
-		int i;
-		ltcsnd_sample_t val = SAMPLE_CENTER;
-		int m = (n+1)>>1;
-		for (i = 0 ; i < m ; i++) {
-			val = val + tcf * (tgtval - val);
-			wave[n-i-1] = wave[i] = val;
+	halfbit(e, &(e->buf[e->offset * e->sample_size]), n, 0, n);
+
+	e->offset += n;
+	return 0;
+}
+
+static long long gcd(long long a, long long b) {
+	while (b) {
+		const long long t = a % b;
+		a = b;
+		b = t;
+	}
+	return a;
+}
+
+/**
+ * Set the sample clock: the length of a half-bit is
+ * (sr_num / sr_den) / (fps_num / fps_den) / 160 samples.
+ * Sample positions are counted in units of 1/clock_unit samples,
+ * so that the half-bit length is an exact integer and the
+ * clock does not drift.
+ *
+ * @return 0 on success, -1 if the values are out of range
+ */
+int encode_set_clock(LTCEncoder *e, long long sr_num, long long sr_den, long long fps_num, long long fps_den) {
+	long long unit, half, g;
+
+	if (sr_num < 1 || sr_den < 1 || fps_num < 1 || fps_den < 1) {
+		return -1;
+	}
+	/* units per bit at speed 10 must fit */
+	if ((double) sr_den * fps_num * 160.0 > 1e15 || (double) sr_num * fps_den > 1e15) {
+		return -1;
+	}
+
+	unit = sr_den * fps_num * 160;
+	half = sr_num * fps_den;
+	g = gcd(unit, half);
+	unit /= g;
+	half /= g;
+	/* the initial remainder is half a sample, and vari-speed
+	 * steps are rounded to units: use at least 2^24 units per sample */
+	while (unit & 1 || (unit < (1LL << 24) && half < (1LL << 40))) {
+		unit *= 2;
+		half *= 2;
+	}
+
+	e->clock_unit = unit;
+	e->clock_q[0] = (2 * half) / unit;
+	e->clock_r[0] = (2 * half) % unit;
+	e->clock_q[1] = half / unit;
+	e->clock_r[1] = half % unit;
+	encode_clock_reset(e);
+	encode_cache_invalidate(e);
+	return 0;
+}
+
+/**
+ * best rational approximation of v with a denominator <= max_den,
+ * using continued fractions
+ */
+static void to_rational(double v, long long max_den, long long *num, long long *den) {
+	long long h0 = 0, h1 = 1, k0 = 1, k1 = 0;
+	double x = v;
+	int i;
+
+	for (i = 0; i < 64; ++i) {
+		const double a = floor(x);
+		const long long h2 = (long long) a * h1 + h0;
+		const long long k2 = (long long) a * k1 + k0;
+		if (k2 > max_den) {
+			break;
+		}
+		h0 = h1; h1 = h2;
+		k0 = k1; k1 = k2;
+		if (x - a < 1e-9 || fabs(v - (double) h1 / k1) < 1e-12 * v) {
+			break;
 		}
+		x = 1.0 / (x - a);
+	}
+	*num = h1;
+	*den = k1;
+}
+
+/**
+ * Set the sample clock from floating point rates.
+ * Frame rates close to n * 1000 / 1001 (29.97, 23.976, 59.94, ..)
+ * are taken to be exactly that.
+ */
+void encode_set_clock_approx(LTCEncoder *e, double sample_rate, double fps) {
+	long long sr_num, sr_den, fps_num, fps_den;
+	const double ntsc = rint(fps * 1.001);
+
+	if (fps != rint(fps) && fabs(fps - ntsc * 1000.0 / 1001.0) < 0.006) {
+		fps_num = ntsc * 1000;
+		fps_den = 1001;
 	} else {
-		/* perfect square wave */
-		memset(wave, tgtval, n);
+		to_rational(fps, 1001, &fps_num, &fps_den);
 	}
+	to_rational(sample_rate, 1001, &sr_num, &sr_den);
 
-	e->offset += n;
-	return 0;
+	if (encode_set_clock(e, sr_num, sr_den, fps_num, fps_den)) {
+		/* out of range, approximate by integers */
+		encode_set_clock(e, sample_rate < 1 ? 1 : rint(sample_rate), 1, fps < 1 ? 1 : rint(fps), 1);
+	}
+}
+
+void encode_clock_reset(LTCEncoder *e) {
+	e->clock_rem = e->clock_unit / 2;
+}
+
+/**
+ * advance the sample clock by q samples and r units
+ * @return number of samples to produce
+ */
+static inline int clock_advance(LTCEncoder *e, int q, long long r) {
+	e->clock_rem += r;
+	if (e->clock_rem >= e->clock_unit) {
+		e->clock_rem -= e->clock_unit;
+		return q + 1;
+	}
+	return q;
+}
+
+/**
+ * biphase-mark transitions of a byte, least significant bit first:
+ * a 0-bit is one full bit-period (0), a 1-bit two half-bit periods (11).
+ * Bit n of the entry is the kind of the n-th transition, 1: half-bit;
+ * the highest set bit terminates the sequence.
+ * Entries have up to 17 bits, int may be 16 bit wide (AVR).
+ */
+static const unsigned long byte_runs[256] = {
+	0x00100, 0x00203, 0x00206, 0x0040f, 0x0020c, 0x0041b, 0x0041e, 0x0083f,
+	0x00218, 0x00433, 0x00436, 0x0086f, 0x0043c, 0x0087b, 0x0087e, 0x010ff,
+	0x00230, 0x00463, 0x00466, 0x008cf, 0x0046c, 0x008db, 0x008de, 0x011bf,
+	0x00478, 0x008f3, 0x008f6, 0x011ef, 0x008fc, 0x011fb, 0x011fe, 0x023ff,
+	0x00260, 0x004c3, 0x004c6, 0x0098f, 0x004cc, 0x0099b, 0x0099e, 0x0133f,
+	0x004d8, 0x009b3, 0x009b6, 0x0136f, 0x009bc, 0x0137b, 0x0137e, 0x026ff,
+	0x004f0, 0x009e3, 0x009e6, 0x013cf, 0x009ec, 0x013db, 0x013de, 0x027bf,
+	0x009f8, 0x013f3, 0x013f6, 0x027ef, 0x013fc, 0x027fb, 0x027fe, 0x04fff,
+	0x002c0, 0x00583, 0x00586, 0x00b0f, 0x0058c, 0x00b1b, 0x00b1e, 0x0163f,
+	0x00598, 0x00b33, 0x00b36, 0x0166f, 0x00b3c, 0x0167b, 0x0167e, 0x02cff,
+	0x005b0, 0x00b63, 0x00b66, 0x016cf, 0x00b6c, 0x016db, 0x016de, 0x02dbf,
+	0x00b78, 0x016f3, 0x016f6, 0x02def, 0x016fc, 0x02dfb, 0x02dfe, 0x05bff,
+	0x005e0, 0x00bc3, 0x00bc6, 0x0178f, 0x00bcc, 0x0179b, 0x0179e, 0x02f3f,
+	0x00bd8, 0x017b3, 0x017b6, 0x02f6f, 0x017bc, 0x02f7b, 0x02f7e, 0x05eff,
+	0x00bf0, 0x017e3, 0x017e6, 0x02fcf, 0x017ec, 0x02fdb, 0x02fde, 0x05fbf,
+	0x017f8, 0x02ff3, 0x02ff6, 0x05fef, 0x02ffc, 0x05ffb, 0x05ffe, 0x0bfff,
+	0x00380, 0x00703, 0x00706, 0x00e0f, 0x0070c, 0x00e1b, 0x00e1e, 0x01c3f,
+	0x00718, 0x00e33, 0x00e36, 0x01c6f, 0x00e3c, 0x01c7b, 0x01c7e, 0x038ff,
+	0x00730, 0x00e63, 0x00e66, 0x01ccf, 0x00e6c, 0x01cdb, 0x01cde, 0x039bf,
+	0x00e78, 0x01cf3, 0x01cf6, 0x039ef, 0x01cfc, 0x039fb, 0x039fe, 0x073ff,
+	0x00760, 0x00ec3, 0x00ec6, 0x01d8f, 0x00ecc, 0x01d9b, 0x01d9e, 0x03b3f,
+	0x00ed8, 0x01db3, 0x01db6, 0x03b6f, 0x01dbc, 0x03b7b, 0x03b7e, 0x076ff,
+	0x00ef0, 0x01de3, 0x01de6, 0x03bcf, 0x01dec, 0x03bdb, 0x03bde, 0x077bf,
+	0x01df8, 0x03bf3, 0x03bf6, 0x077ef, 0x03bfc, 0x077fb, 0x077fe, 0x0efff,
+	0x007c0, 0x00f83, 0x00f86, 0x01f0f, 0x00f8c, 0x01f1b, 0x01f1e, 0x03e3f,
+	0x00f98, 0x01f33, 0x01f36, 0x03e6f, 0x01f3c, 0x03e7b, 0x03e7e, 0x07cff,
+	0x00fb0, 0x01f63, 0x01f66, 0x03ecf, 0x01f6c, 0x03edb, 0x03ede, 0x07dbf,
+	0x01f78, 0x03ef3, 0x03ef6, 0x07def, 0x03efc, 0x07dfb, 0x07dfe, 0x0fbff,
+	0x00fe0, 0x01fc3, 0x01fc6, 0x03f8f, 0x01fcc, 0x03f9b, 0x03f9e, 0x07f3f,
+	0x01fd8, 0x03fb3, 0x03fb6, 0x07f6f, 0x03fbc, 0x07f7b, 0x07f7e, 0x0feff,
+	0x01ff0, 0x03fe3, 0x03fe6, 0x07fcf, 0x03fec, 0x07fdb, 0x07fde, 0x0ffbf,
+	0x03ff8, 0x07ff3, 0x07ff6, 0x0ffef, 0x07ffc, 0x0fffb, 0x0fffe, 0x1ffff,
+};
+
+/**
+ * emit the transitions of a byte
+ * @param q,r clock steps for a [0]: bit, [1]: half-bit
+ */
+static inline int encode_runs(LTCEncoder *e, unsigned long runs, const int *q, const long long *r) {
+	int err = 0;
+	for (; runs > 1; runs >>= 1) {
+		const int k = runs & 1;
+		const int n = clock_advance(e, q[k], r[k]);
+		e->state = !e->state;
+		err |= addvalues(e, n);
+	}
+	return err;
+}
+
+/**
+ * Drop all cached waveforms, and resize the cache to hold the longest
+ * possible byte. Needs to be called whenever the waveform of a byte
+ * changes: clock, filter, volume or sample format.
+ */
+void encode_cache_invalidate(LTCEncoder *e) {
+	size_t len, size;
+	int i;
+
+	if (e->cache_len == 0) {
+		return;
+	}
+	for (i = 0; i < LTC_FRAME_BIT_COUNT / 8; ++i) {
+		e->cache[i].valid = 0;
+	}
+
+	/* 8 bits, each rounded up by at most one sample */
+	len = 8 * (e->clock_q[0] + 1);
+	size = len * e->sample_size * (LTC_FRAME_BIT_COUNT / 8);
+	if (size != e->cache_size) {
+		unsigned char *buf = (unsigned char*) realloc(e->cache_buf, size);
+		if (!buf) {
+			free(e->cache_buf);
+			e->cache_buf = NULL;
+			e->cache_len = 0;
+			e->cache_size = 0;
+			return;
+		}
+		e->cache_buf = buf;
+		e->cache_size = size;
+	}
+	e->cache_len = len;
+}
+
+int encode_cache_enable(LTCEncoder *e, int enable) {
+	if (!enable) {
+		free(e->cache_buf);
+		e->cache_buf = NULL;
+		e->cache_len = 0;
+		e->cache_size = 0;
+		return 0;
+	}
+	if (e->cache_len > 0) {
+		return 0;
+	}
+	/* any value != 0, the buffer is sized by encode_cache_invalidate() */
+	e->cache_len = (size_t) -1;
+	encode_cache_invalidate(e);
+	return e->cache_len > 0 ? 0 : -1;
+}
+
+/**
+ * Encode a byte at speed 1.0 or -1.0. If the waveform cache is
+ * enabled and the byte was last encoded with the same value, signal state
+ * and sub-sample position, the samples are copied from the cache,
+ * otherwise the byte is rendered and stored in the cache.
+ */
+static int encode_cached_byte(LTCEncoder *e, int byte, int reverse) {
+	const unsigned char c = ((unsigned char*)&e->f)[byte];
+	const unsigned long runs = byte_runs[reverse ? bit_reverse[c] : c];
+	struct LTCEncoderCacheEntry *ce = &e->cache[byte];
+	const size_t ss = e->sample_size;
+	const size_t offset = e->offset;
+	const char state = e->state;
+	const long long rem = e->clock_rem;
+	int err;
+
+	if (e->cache_len == 0) {
+		return encode_runs(e, runs, e->clock_q, e->clock_r);
+	}
+
+	if (ce->valid && ce->value == c && ce->reverse == reverse && ce->state == state && ce->rem == rem
+			&& offset + ce->len < e->bufsize) {
+		memcpy(&e->buf[offset * ss], &e->cache_buf[byte * e->cache_len * ss], ce->len * ss);
+		e->offset += ce->len;
+		e->clock_rem = ce->rem_out;
+		e->state = ce->state_out;
+		return 0;
+	}
+
+	err = encode_runs(e, runs, e->clock_q, e->clock_r);
+
+	ce->valid = !err && e->offset - offset <= e->cache_len;
+	if (ce->valid) {
+		ce->value = c;
+		ce->reverse = reverse;
+		ce->state = state;
+		ce->rem = rem;
+		ce->rem_out = e->clock_rem;
+		ce->state_out = e->state;
+		ce->len = e->offset - offset;
+		memcpy(&e->cache_buf[byte * e->cache_len * ss], &e->buf[offset * ss], ce->len * ss);
+	}
+	return err;
 }
 
 int encode_byte(LTCEncoder *e, int byte, double speed) {
 	if (byte < 0 || byte > 9) return -1;
 	if (speed ==0) return -1;
 
-	int err = 0;
 	const unsigned char c = ((unsigned char*)&e->f)[byte];
-	unsigned char b = (speed < 0)?128:1; // bit
-	const double spc = e->samples_per_clock * fabs(speed);
-	const double sph = e->samples_per_clock_2 * fabs(speed);
-
-	do
-	{
-		int n;
-		if ((c & b) == 0) {
-			n = (int)(spc + e->sample_remainder);
-			e->sample_remainder = spc + e->sample_remainder - n;
-			e->state = !e->state;
-			err |= addvalues(e, n);
-		} else {
-			n = (int)(sph + e->sample_remainder);
-			e->sample_remainder = sph + e->sample_remainder - n;
-			e->state = !e->state;
-			err |= addvalues(e, n);
+	const unsigned long runs = byte_runs[(speed < 0) ? bit_reverse[c] : c];
 
-			n = (int)(sph + e->sample_remainder);
-			e->sample_remainder = sph + e->sample_remainder - n;
-			e->state = !e->state;
-			err |= addvalues(e, n);
+	if (fabs(speed) != 1.0) {
+		/* vari-speed, rounded to the clock resolution */
+		int q[2], k;
+		long long r[2];
+		for (k = 0; k < 2; ++k) {
+			const long long step = (long long) floor((e->clock_q[k] * e->clock_unit + e->clock_r[k]) * fabs(speed) + 0.5);
+			q[k] = step / e->clock_unit;
+			r[k] = step % e->clock_unit;
 		}
-		/* this is based on the assumption that with every compiler
-		 * ((unsigned char) 128)<<1 == ((unsigned char 1)>>1) == 0
-		 */
-		if (speed < 0)
-			b >>= 1;
-		else
-			b <<= 1;
-	} while (b);
+		return encode_runs(e, runs, q, r);
+	}
+
+	return encode_cached_byte(e, byte, speed < 0);
+}
 
+int encode_frame(LTCEncoder *e, int reverse) {
+	int err = 0;
+	int byte;
+
+	if (reverse) {
+		for (byte = LTC_FRAME_BIT_COUNT / 8 - 1; byte >= 0; --byte) {
+			err |= encode_cached_byte(e, byte, 1);
+		}
+	} else {
+		for (byte = 0; byte < LTC_FRAME_BIT_COUNT / 8; ++byte) {
+			err |= encode_cached_byte(e, byte, 0);
+		}
+	}
 	return err;
 }
 
@@ -124,3 +619,139 @@ int encode_transition(LTCEncoder *e) {
 
 	return err;
 }
+
+/**
+ * advance the sample clock by n times q samples and r units (r < clock_unit)
+ * @return number of samples
+ */
+static long long clock_skip(LTCEncoder *e, long long n, long long q, long long r) {
+	long long samples = n * q;
+	/* n * r may overflow: add r * 2^k for each set bit k of n,
+	 * rq and rr are the whole samples and remaining units of r * 2^k */
+	long long rq = 0, rr = r;
+
+	for (; n > 0; n >>= 1) {
+		if (n & 1) {
+			samples += rq;
+			e->clock_rem += rr;
+			if (e->clock_rem >= e->clock_unit) {
+				e->clock_rem -= e->clock_unit;
+				++samples;
+			}
+		}
+		rq *= 2;
+		rr *= 2;
+		if (rr >= e->clock_unit) {
+			rr -= e->clock_unit;
+			++rq;
+		}
+	}
+	return samples;
+}
+
+/**
+ * parity of the number of transitions of a frame:
+ * one per 0-bit and two per 1-bit
+ */
+static int frame_transition_parity(const LTCFrame *f) {
+	const unsigned char *b = (const unsigned char*) f;
+	unsigned int p = b[0] ^ b[1] ^ b[2] ^ b[3] ^ b[4] ^ b[5] ^ b[6] ^ b[7] ^ b[8] ^ b[9];
+	p ^= p >> 4;
+	return (0x6996 >> (p & 0x0F)) & 1;
+}
+
+ltc_off_t encode_skip_frames(LTCEncoder *e, int n_frames) {
+	const int fps = rint(e->fps);
+	ltc_off_t skipped = 0;
+	long long q, r;
+
+	if (e->render_byte != 0 || e->render_runs > 1 || e->render_pos >= 0) {
+		/* complete the frame in progress */
+		size_t n;
+		encode_render(e, NULL, (size_t) -1, 1, &n);
+		skipped = n;
+		--n_frames;
+	}
+	if (n_frames < 1) {
+		return skipped;
+	}
+
+	/* every frame spans 80 bits on the sample clock */
+	q = 80LL * e->clock_q[0] + (80 * e->clock_r[0]) / e->clock_unit;
+	r = (80 * e->clock_r[0]) % e->clock_unit;
+	skipped += clock_skip(e, n_frames, q, r);
+
+	/* the signal polarity toggles with every transition */
+	if (e->flags & LTC_NO_PARITY) {
+		for (; n_frames > 0; --n_frames) {
+			e->state ^= frame_transition_parity(&e->f);
+			ltc_frame_increment(&e->f, fps, e->standard, e->flags);
+		}
+	} else {
+		/* the parity bit of all following frames is set by
+		 * ltc_frame_increment(), so that their polarity does not change */
+		e->state ^= frame_transition_parity(&e->f);
+		ltc_frame_add(&e->f, n_frames, fps, e->standard, e->flags);
+	}
+	return skipped;
+}
+
+void encode_render_reset(LTCEncoder *e) {
+	e->render_byte = 0;
+	e->render_runs = 0;
+	e->render_pos = -1;
+}
+
+int encode_render(LTCEncoder *e, unsigned char *buf, size_t size, int max_frames, size_t *n_written) {
+	const size_t ss = e->sample_size;
+	size_t written = 0;
+	int frames = 0;
+
+	while (written < size && (max_frames <= 0 || frames < max_frames)) {
+		int cnt;
+
+		if (e->render_pos < 0) {
+			/* start the next transition */
+			int k;
+			if (e->render_runs <= 1) {
+				e->render_runs = byte_runs[((unsigned char*)&e->f)[e->render_byte]];
+			}
+			k = e->render_runs & 1;
+			e->render_n = clock_advance(e, e->clock_q[k], e->clock_r[k]);
+			e->state = !e->state;
+			e->render_pos = 0;
+		}
+
+		cnt = e->render_n - e->render_pos;
+		if ((size_t) cnt > size - written) {
+			cnt = size - written;
+		}
+		if (buf) {
+			halfbit(e, &buf[written * ss], e->render_n, e->render_pos, cnt);
+		}
+		e->render_pos += cnt;
+		written += cnt;
+
+		if (e->render_pos < e->render_n) {
+			/* out of space, resume with the next call */
+			break;
+		}
+
+		e->render_pos = -1;
+		e->render_runs >>= 1;
+		if (e->render_runs > 1) {
+			continue;
+		}
+		if (++e->render_byte < LTC_FRAME_BIT_COUNT / 8) {
+			continue;
+		}
+		e->render_byte = 0;
+		ltc_frame_increment(&e->f, rint(e->fps), e->standard, e->flags);
+		++frames;
+	}
+
+	if (n_written) {
+		*n_written = written;
+	}
+	return frames;
+}
@@ -23,26 +23,90 @@
 #define SAMPLE_CENTER 128 // unsigned 8 bit.
 #endif
 
+/** max length of a precomputed edge, longer edges are completed by addvalues() */
+#define ENCODER_EDGE_LEN 256
+
+/** largest sample size of \ref LTC_SAMPLE_FORMAT */
+#define ENCODER_MAX_SAMPLE_SIZE 4
+
+/**
+ * low-pass filtered transition from the center towards the high or low
+ * level, in the encoder's sample format. see encode_prepare_edges()
+ */
+struct LTCEncoderEdge {
+	unsigned char *ramp; ///< rising (or falling) part of a half-bit, len samples in the encoder's format, NULL without filter
+	unsigned char *tail; ///< ramp in reverse order, shares the allocation of ramp
+	unsigned char level[ENCODER_MAX_SAMPLE_SIZE]; ///< target sample, used for square waves
+	int len; ///< samples in ramp and tail
+	int settled; ///< if set, all samples after the ramp equal the last ramp sample
+	double last; ///< filter state after the last ramp sample
+};
+
+/**
+ * rendered waveform of one byte of the frame, see encode_cached_byte()
+ */
+struct LTCEncoderCacheEntry {
+	int valid;
+	unsigned char value; ///< byte value
+	char reverse; ///< encoded backwards
+	char state; ///< signal state before the byte
+	long long rem; ///< clock_rem before the byte
+	char state_out; ///< signal state after the byte
+	long long rem_out; ///< clock_rem after the byte
+	int len; ///< samples
+};
+
 struct LTCEncoder {
 	double fps;
 	double sample_rate;
 	double filter_const;
 	int flags;
 	enum LTC_TV_STANDARD standard;
-	ltcsnd_sample_t enc_lo, enc_hi;
+	ltcsnd_sample_t enc_lo, enc_hi; ///< signal levels for LTC_SAMPLE_U8
+	double volume; ///< linear signal level for all other sample formats
+
+	enum LTC_SAMPLE_FORMAT format;
+	size_t sample_size;
 
-	size_t offset;
-	size_t bufsize;
-	ltcsnd_sample_t *buf;
+	size_t offset; ///< in samples
+	size_t bufsize; ///< in samples
+	unsigned char *buf;
 
 	char state;
 
-	double samples_per_clock;
-	double samples_per_clock_2;
-	double sample_remainder;
+	/* sample clock, exact rational: clock_unit units per sample */
+	long long clock_unit;
+	int clock_q[2]; ///< whole samples per [0]: bit, [1]: half-bit at speed 1.0
+	long long clock_r[2]; ///< remaining units per [0]: bit, [1]: half-bit
+	long long clock_rem; ///< sub-sample position in units 0..clock_unit-1
 
 	LTCFrame f;
+
+	struct LTCEncoderEdge edge[2]; ///< index: state
+
+	/* waveform cache, one entry per byte of the frame */
+	struct LTCEncoderCacheEntry cache[LTC_FRAME_BIT_COUNT / 8];
+	unsigned char *cache_buf;
+	size_t cache_len; ///< samples per entry, 0: cache disabled
+	size_t cache_size; ///< allocated bytes of cache_buf
+
+	/* position of encode_render() in the current frame */
+	int render_byte; ///< byte of the frame 0..9
+	unsigned long render_runs; ///< transitions left in render_byte, see byte_runs (17 bits), <= 1: start the next byte
+	int render_n; ///< length of the half-bit in progress
+	int render_pos; ///< samples of the half-bit in progress already written, -1: none
 };
 
+size_t encode_sample_size(enum LTC_SAMPLE_FORMAT format);
 int encode_byte(LTCEncoder *e, int byte, double speed);
+int encode_frame(LTCEncoder *e, int reverse);
 int encode_transition(LTCEncoder *e);
+void encode_prepare_edges(LTCEncoder *e);
+void encode_render_reset(LTCEncoder *e);
+int encode_set_clock(LTCEncoder *e, long long sr_num, long long sr_den, long long fps_num, long long fps_den);
+void encode_set_clock_approx(LTCEncoder *e, double sample_rate, double fps);
+void encode_clock_reset(LTCEncoder *e);
+int encode_cache_enable(LTCEncoder *e, int enable);
+void encode_cache_invalidate(LTCEncoder *e);
+int encode_render(LTCEncoder *e, unsigned char *buf, size_t size, int max_frames, size_t *n_written);
+ltc_off_t encode_skip_frames(LTCEncoder *e, int n_frames);
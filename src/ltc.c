@@ -26,19 +26,20 @@
 #include "ltc.h"
 #include "decoder.h"
 #include "encoder.h"
-
-#if (defined _MSC_VER && _MSC_VER < 1800) || (defined __AVR__)
-static double rint(double v) {
-	// NB. this is identical to round(), not rint(), but the difference is not relevant here
-	return floor(v + 0.5);
-}
-#endif
+#include "compat.h"
 
 /* -+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
  * Decoder
  */
 
 LTCDecoder* ltc_decoder_create(int apv, int queue_len) {
+	return ltc_decoder_create_ext(apv, queue_len, 0);
+}
+
+LTCDecoder* ltc_decoder_create_ext(int apv, int queue_len, int flags) {
+#ifdef LTC_NO_ATOMICS
+	if (flags & LTC_DECODER_SPSC) return NULL;
+#endif
 	LTCDecoder* d = (LTCDecoder*) calloc(1, sizeof(LTCDecoder));
 	if (!d) return NULL;
 
@@ -46,12 +47,18 @@ LTCDecoder* ltc_decoder_create(int apv, int queue_len) {
 		queue_len = 1;
 	}
 
-	d->queue_len = queue_len;
-	d->queue = (LTCFrameExt*) calloc(d->queue_len, sizeof(LTCFrameExt));
-	if (!d->queue) {
+	/* one entry remains unused to tell a full from an empty queue */
+	d->queue_len = queue_len + 1;
+	if (flags & LTC_DECODER_COMPACT) {
+		d->queue_compact = (LTCFrameCompact*) calloc(d->queue_len, sizeof(LTCFrameCompact));
+	} else {
+		d->queue = (LTCFrameExt*) calloc(d->queue_len, sizeof(LTCFrameExt));
+	}
+	if (!d->queue && !d->queue_compact) {
 		free(d);
 		return NULL;
 	}
+	d->flags = flags;
 	d->biphase_state = 1;
 	d->snd_to_biphase_period = apv / 80;
 	d->snd_to_biphase_lmt = (d->snd_to_biphase_period * 3) / 4;
@@ -67,6 +74,7 @@ LTCDecoder* ltc_decoder_create(int apv, int queue_len) {
 int ltc_decoder_free(LTCDecoder *d) {
 	if (!d) return 1;
 	if (d->queue) free(d->queue);
+	if (d->queue_compact) free(d->queue_compact);
 	free(d);
 
 	return 0;
@@ -76,52 +84,199 @@ void ltc_decoder_write(LTCDecoder *d, ltcsnd_sample_t *buf, size_t size, ltc_off
 	decode_ltc(d, buf, size, posinfo);
 }
 
-#define LTC_CONVERSION_BUF_SIZE 1024
+void ltc_decoder_write_double(LTCDecoder *d, double *buf, size_t size, ltc_off_t posinfo) {
+	decode_ltc_double(d, buf, size, 1, posinfo);
+}
+
+void ltc_decoder_write_float(LTCDecoder *d, float *buf, size_t size, ltc_off_t posinfo) {
+	decode_ltc_float(d, buf, size, 1, posinfo);
+}
 
-#define LTCWRITE_TEMPLATE(FN, FORMAT, CONV) \
-void ltc_decoder_write_ ## FN (LTCDecoder *d, FORMAT *buf, size_t size, ltc_off_t posinfo) { \
-	ltcsnd_sample_t tmp[LTC_CONVERSION_BUF_SIZE]; \
-	size_t copyStart = 0; \
-	while (copyStart < size) { \
-		int i; \
-		int c = size - copyStart; \
-		c = (c > LTC_CONVERSION_BUF_SIZE) ? LTC_CONVERSION_BUF_SIZE : c; \
-		for (i=0; i < c; i++) { \
-			tmp[i] = CONV; \
+void ltc_decoder_write_s16(LTCDecoder *d, short *buf, size_t size, ltc_off_t posinfo) {
+	decode_ltc_s16(d, buf, size, 1, posinfo);
+}
+
+void ltc_decoder_write_u16(LTCDecoder *d, unsigned short *buf, size_t size, ltc_off_t posinfo) {
+	decode_ltc_u16(d, buf, size, 1, posinfo);
+}
+
+void ltc_decoder_write_strided(LTCDecoder *d, ltcsnd_sample_t *buf, size_t size, size_t stride, ltc_off_t posinfo) {
+	decode_ltc_strided(d, buf, size, stride, posinfo);
+}
+
+void ltc_decoder_write_double_strided(LTCDecoder *d, double *buf, size_t size, size_t stride, ltc_off_t posinfo) {
+	decode_ltc_double(d, buf, size, stride, posinfo);
+}
+
+void ltc_decoder_write_float_strided(LTCDecoder *d, float *buf, size_t size, size_t stride, ltc_off_t posinfo) {
+	decode_ltc_float(d, buf, size, stride, posinfo);
+}
+
+void ltc_decoder_write_s16_strided(LTCDecoder *d, short *buf, size_t size, size_t stride, ltc_off_t posinfo) {
+	decode_ltc_s16(d, buf, size, stride, posinfo);
+}
+
+void ltc_decoder_write_u16_strided(LTCDecoder *d, unsigned short *buf, size_t size, size_t stride, ltc_off_t posinfo) {
+	decode_ltc_u16(d, buf, size, stride, posinfo);
+}
+
+/* interleaved buffers are processed in blocks of this many
+ * audio-frames, so that each block remains in cache while
+ * all channels are decoded.
+ */
+#define LTC_INTERLEAVED_BLOCK_SIZE 64
+
+#define LTCWRITE_INTERLEAVED_TEMPLATE(FN, FORMAT, DECODE) \
+void ltc_decoder_write_ ## FN (LTCDecoder **d, int n_channels, FORMAT *buf, size_t size, ltc_off_t posinfo) { \
+	size_t off = 0; \
+	while (off < size) { \
+		int c; \
+		size_t n = size - off; \
+		n = (n > LTC_INTERLEAVED_BLOCK_SIZE) ? LTC_INTERLEAVED_BLOCK_SIZE : n; \
+		for (c = 0; c < n_channels; ++c) { \
+			if (!d[c]) continue; \
+			DECODE(d[c], &buf[off * n_channels + c], n, n_channels, posinfo + (ltc_off_t)off); \
 		} \
-		decode_ltc(d, tmp, c, posinfo + (ltc_off_t)copyStart); \
-		copyStart += c; \
+		off += n; \
 	} \
 }
 
-LTCWRITE_TEMPLATE(double, double, 128 + (buf[copyStart+i] * 127.0))
-LTCWRITE_TEMPLATE(float, float, 128 + (buf[copyStart+i] * 127.f))
-/* this relies on the compiler to use an arithmetic right-shift for signed values */
-LTCWRITE_TEMPLATE(s16, short, 128 + (buf[copyStart+i] >> 8))
-/* this relies on the compiler to use a logical right-shift for unsigned values */
-LTCWRITE_TEMPLATE(u16, unsigned short, (buf[copyStart+i] >> 8))
+LTCWRITE_INTERLEAVED_TEMPLATE(interleaved, ltcsnd_sample_t, decode_ltc_strided)
+LTCWRITE_INTERLEAVED_TEMPLATE(double_interleaved, double, decode_ltc_double)
+LTCWRITE_INTERLEAVED_TEMPLATE(float_interleaved, float, decode_ltc_float)
+LTCWRITE_INTERLEAVED_TEMPLATE(s16_interleaved, short, decode_ltc_s16)
+LTCWRITE_INTERLEAVED_TEMPLATE(u16_interleaved, unsigned short, decode_ltc_u16)
 
-#undef LTC_CONVERSION_BUF_SIZE
+#undef LTC_INTERLEAVED_BLOCK_SIZE
 
 int ltc_decoder_read(LTCDecoder* d, LTCFrameExt* frame) {
 	if (!frame) return -1;
-	if (d->queue_read_off != d->queue_write_off) {
-		if (d->queue_read_off == d->queue_len) {
-			d->queue_read_off = 0;
+	const int read_off = d->queue_read_off;
+	if (read_off != LTC_LOAD_ACQUIRE(&d->queue_write_off)) {
+		if (d->queue_compact) {
+			const LTCFrameCompact *cframe = &d->queue_compact[read_off];
+			memset(frame, 0, sizeof(LTCFrameExt));
+			memcpy(&frame->ltc, &cframe->ltc, sizeof(LTCFrame));
+			frame->off_start = cframe->off_start;
+			frame->off_end = cframe->off_end;
+			frame->reverse = cframe->reverse;
+			frame->volume = -HUGE_VAL; /* not measured, 0 would read as full scale */
+		} else {
+			memcpy(frame, &d->queue[read_off], sizeof(LTCFrameExt));
+		}
+		LTC_STORE_RELEASE(&d->queue_read_off, (read_off + 1) % d->queue_len);
+		return 1;
+	}
+	return 0;
+}
+
+int ltc_decoder_read_compact(LTCDecoder* d, LTCFrameCompact* frame) {
+	if (!frame) return -1;
+	const int read_off = d->queue_read_off;
+	if (read_off != LTC_LOAD_ACQUIRE(&d->queue_write_off)) {
+		if (d->queue_compact) {
+			memcpy(frame, &d->queue_compact[read_off], sizeof(LTCFrameCompact));
+		} else {
+			const LTCFrameExt *xframe = &d->queue[read_off];
+			memcpy(&frame->ltc, &xframe->ltc, sizeof(LTCFrame));
+			frame->off_start = xframe->off_start;
+			frame->off_end = xframe->off_end;
+			frame->reverse = xframe->reverse;
 		}
-		memcpy(frame, &d->queue[d->queue_read_off], sizeof(LTCFrameExt));
-		d->queue_read_off++;
+		LTC_STORE_RELEASE(&d->queue_read_off, (read_off + 1) % d->queue_len);
 		return 1;
 	}
 	return 0;
 }
 
+void ltc_decoder_set_frame_callback(LTCDecoder *d, ltc_decoder_frame_callback cb, void *arg) {
+	d->frame_cb = cb;
+	d->frame_cb_arg = arg;
+}
+
 void ltc_decoder_queue_flush(LTCDecoder* d) {
-	d->queue_read_off = d->queue_write_off;
+	LTC_STORE_RELEASE(&d->queue_read_off, LTC_LOAD_ACQUIRE(&d->queue_write_off));
 }
 
 int ltc_decoder_queue_length(LTCDecoder* d) {
-	return (d->queue_write_off - d->queue_read_off + d->queue_len) % d->queue_len;
+	const int write_off = LTC_LOAD_ACQUIRE(&d->queue_write_off);
+	const int read_off = LTC_LOAD_ACQUIRE(&d->queue_read_off);
+	return (write_off - read_off + d->queue_len) % d->queue_len;
+}
+
+/* -+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+ * Decoder Bank
+ */
+
+LTCDecoderBank* ltc_decoder_bank_create(int n_channels, int apv, int queue_len) {
+	int c;
+	if (n_channels < 1) return NULL;
+
+	LTCDecoderBank* b = (LTCDecoderBank*) calloc(1, sizeof(LTCDecoderBank));
+	if (!b) return NULL;
+
+	b->n_channels = n_channels;
+	b->decoder = (LTCDecoder**) calloc(n_channels, sizeof(LTCDecoder*));
+	b->snd_to_biphase_min = (ltcsnd_sample_t*) calloc(n_channels, sizeof(ltcsnd_sample_t));
+	b->snd_to_biphase_max = (ltcsnd_sample_t*) calloc(n_channels, sizeof(ltcsnd_sample_t));
+	b->snd_to_biphase_cnt = (int*) calloc(n_channels, sizeof(int));
+	b->snd_to_biphase_state = (unsigned char*) calloc(n_channels, sizeof(unsigned char));
+
+	if (!b->decoder || !b->snd_to_biphase_min || !b->snd_to_biphase_max
+			|| !b->snd_to_biphase_cnt || !b->snd_to_biphase_state) {
+		ltc_decoder_bank_free(b);
+		return NULL;
+	}
+
+	for (c = 0; c < n_channels; ++c) {
+		b->decoder[c] = ltc_decoder_create(apv, queue_len);
+		if (!b->decoder[c]) {
+			ltc_decoder_bank_free(b);
+			return NULL;
+		}
+		b->snd_to_biphase_min[c] = b->decoder[c]->snd_to_biphase_min;
+		b->snd_to_biphase_max[c] = b->decoder[c]->snd_to_biphase_max;
+		b->snd_to_biphase_cnt[c] = b->decoder[c]->snd_to_biphase_cnt;
+		b->snd_to_biphase_state[c] = b->decoder[c]->snd_to_biphase_state;
+	}
+	return b;
+}
+
+int ltc_decoder_bank_free(LTCDecoderBank *b) {
+	int c;
+	if (!b) return 1;
+	if (b->decoder) {
+		for (c = 0; c < b->n_channels; ++c) {
+			ltc_decoder_free(b->decoder[c]);
+		}
+		free(b->decoder);
+	}
+	free(b->snd_to_biphase_min);
+	free(b->snd_to_biphase_max);
+	free(b->snd_to_biphase_cnt);
+	free(b->snd_to_biphase_state);
+	free(b);
+	return 0;
+}
+
+void ltc_decoder_bank_write(LTCDecoderBank *b, ltcsnd_sample_t *buf, size_t size, ltc_off_t posinfo) {
+	decode_ltc_bank(b, buf, size, posinfo);
+}
+
+int ltc_decoder_bank_read(LTCDecoderBank *b, int channel, LTCFrameExt *frame) {
+	if (channel < 0 || channel >= b->n_channels) return -1;
+	return ltc_decoder_read(b->decoder[channel], frame);
+}
+
+int ltc_decoder_bank_set_frame_callback(LTCDecoderBank *b, int channel, ltc_decoder_frame_callback cb, void *arg) {
+	if (channel < 0 || channel >= b->n_channels) return -1;
+	ltc_decoder_set_frame_callback(b->decoder[channel], cb, arg);
+	return 0;
+}
+
+int ltc_decoder_bank_queue_length(LTCDecoderBank *b, int channel) {
+	if (channel < 0 || channel >= b->n_channels) return -1;
+	return ltc_decoder_queue_length(b->decoder[channel]);
 }
 
 /* -+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
@@ -139,9 +294,13 @@ LTCEncoder* ltc_encoder_create(double sample_rate, double fps, enum LTC_TV_STAND
 	/*-3.0 dBFS default */
 	e->enc_lo = 38;
 	e->enc_hi = 218;
+	e->volume = pow(10, -3.0 / 20.0);
+
+	e->format = LTC_SAMPLE_U8;
+	e->sample_size = sizeof(ltcsnd_sample_t);
 
 	e->bufsize = 1 + ceil(sample_rate / fps);
-	e->buf = (ltcsnd_sample_t*) calloc(e->bufsize, sizeof(ltcsnd_sample_t));
+	e->buf = (unsigned char*) calloc(e->bufsize, e->sample_size);
 	if (!e->buf) {
 		free(e);
 		return NULL;
@@ -155,6 +314,9 @@ LTCEncoder* ltc_encoder_create(double sample_rate, double fps, enum LTC_TV_STAND
 void ltc_encoder_free(LTCEncoder *e) {
 	if (!e) return;
 	if (e->buf) free(e->buf);
+	free(e->cache_buf);
+	free(e->edge[0].ramp);
+	free(e->edge[1].ramp);
 	free(e);
 }
 
@@ -174,9 +336,8 @@ int ltc_encoder_reinit(LTCEncoder *e, double sample_rate, double fps, enum LTC_T
 	e->fps = fps;
 	e->flags = flags;
 	e->standard = standard;
-	e->samples_per_clock = sample_rate / (fps * 80.0);
-	e->samples_per_clock_2 = e->samples_per_clock / 2.0;
-	e->sample_remainder = 0.5;
+	encode_set_clock_approx(e, sample_rate, fps);
+	encode_render_reset(e);
 
 	if (flags & LTC_BGF_DONT_TOUCH) {
 		e->f.col_frame = 0;
@@ -207,13 +368,25 @@ int ltc_encoder_reinit(LTCEncoder *e, double sample_rate, double fps, enum LTC_T
 	return 0;
 }
 
+int ltc_encoder_reinit_rational(LTCEncoder *e, int sample_rate_num, int sample_rate_den, int fps_num, int fps_den, enum LTC_TV_STANDARD standard, int flags) {
+	if (sample_rate_num < 1 || sample_rate_den < 1 || fps_num < 1 || fps_den < 1)
+		return -1;
+	if (ltc_encoder_reinit(e, (double) sample_rate_num / sample_rate_den, (double) fps_num / fps_den, standard, flags))
+		return -1;
+	return encode_set_clock(e, sample_rate_num, sample_rate_den, fps_num, fps_den);
+}
+
 void ltc_encoder_reset(LTCEncoder *e) {
 	e->state = 0;
-	e->sample_remainder = 0.5;
 	e->offset = 0;
+	encode_clock_reset(e);
+	encode_render_reset(e);
 }
 
 double ltc_encoder_get_volume(LTCEncoder *e) {
+    if (e->format != LTC_SAMPLE_U8) {
+        return 20.0 * log10(e->volume);
+    }
     ltcsnd_sample_t diff = (e->enc_hi - e->enc_lo) / 2;
     return 20.0 * log10((double)diff / 127.0);
 }
@@ -222,14 +395,41 @@ int ltc_encoder_set_volume(LTCEncoder *e, double dBFS) {
 	if (dBFS > 0)
 		return -1;
 	double pp = rint(127.0 * pow(10, dBFS/20.0));
-	if (pp < 1 || pp > 127)
+	if (pp > 127)
 		return -1;
+	if (pp < 1) {
+		/* below 8 bit resolution */
+		if (e->format == LTC_SAMPLE_U8)
+			return -1;
+		pp = 1;
+	}
 	ltcsnd_sample_t diff = ((ltcsnd_sample_t) pp)&0x7f;
 	e->enc_lo = SAMPLE_CENTER - diff;
 	e->enc_hi = SAMPLE_CENTER + diff;
+	e->volume = pow(10, dBFS/20.0);
+	encode_prepare_edges(e);
 	return 0;
 }
 
+int ltc_encoder_set_sample_format(LTCEncoder *e, enum LTC_SAMPLE_FORMAT format) {
+	const size_t sample_size = encode_sample_size(format);
+	unsigned char *buf = (unsigned char*) calloc(e->bufsize, sample_size);
+	if (!buf) {
+		return -1;
+	}
+	free(e->buf);
+	e->buf = buf;
+	e->offset = 0;
+	e->format = format;
+	e->sample_size = sample_size;
+	encode_prepare_edges(e);
+	return 0;
+}
+
+enum LTC_SAMPLE_FORMAT ltc_encoder_get_sample_format(LTCEncoder *e) {
+	return e->format;
+}
+
 double ltc_encoder_get_filter(LTCEncoder *e) {
     const double num = -2000000.0 * exp(1.0);
     const double den = e->sample_rate * log(1.0 - e->filter_const);
@@ -249,13 +449,19 @@ void ltc_encoder_set_filter(LTCEncoder *e, double rise_time) {
 		e->filter_const = 0;
 	else
 		e->filter_const = 1.0 - exp( -1.0 / (e->sample_rate * rise_time / 2000000.0 / exp(1.0)) );
+
+	encode_prepare_edges(e);
+}
+
+int ltc_encoder_set_waveform_cache(LTCEncoder *e, int enable) {
+	return encode_cache_enable(e, enable);
 }
 
 int ltc_encoder_set_buffersize(LTCEncoder *e, double sample_rate, double fps) {
 	free (e->buf);
 	e->offset = 0;
 	e->bufsize = 1 + ceil(sample_rate / fps);
-	e->buf = (ltcsnd_sample_t*) calloc(e->bufsize, sizeof(ltcsnd_sample_t));
+	e->buf = (unsigned char*) calloc(e->bufsize, e->sample_size);
 	if (!e->buf) {
 		return -1;
 	}
@@ -275,17 +481,28 @@ int ltc_encoder_end_encode(LTCEncoder *e) {
 }
 
 void ltc_encoder_encode_frame(LTCEncoder *e) {
-	int byte;
-	for (byte = 0 ; byte < 10 ; byte++) {
-		encode_byte(e, byte, 1.0);
-	}
+	encode_frame(e, 0);
+}
+
+int ltc_encoder_render(LTCEncoder *e, void *buf, size_t size) {
+	if (!buf) return -1;
+	return encode_render(e, (unsigned char*) buf, size, 0, NULL);
+}
+
+ltc_off_t ltc_encoder_skip_frames(LTCEncoder *e, int n_frames) {
+	if (n_frames < 1) return 0;
+	return encode_skip_frames(e, n_frames);
+}
+
+ltc_off_t ltc_encoder_render_frames(LTCEncoder *e, int n_frames, void *buf, size_t size) {
+	size_t written;
+	if (!buf || n_frames < 1) return -1;
+	encode_render(e, (unsigned char*) buf, size, n_frames, &written);
+	return written;
 }
 
 void ltc_encoder_encode_reversed_frame(LTCEncoder *e) {
-	int byte;
-	for (byte = 9 ; byte >= 0 ; --byte) {
-		encode_byte(e, byte, -1.0);
-	}
+	encode_frame(e, 1);
 }
 
 void ltc_encoder_get_timecode(LTCEncoder *e, SMPTETimecode *t) {
@@ -374,36 +591,42 @@ ltcsnd_sample_t *ltc_encoder_get_bufptr(LTCEncoder *e, int *size, int flush) {
 
 int ltc_encoder_copy_buffer(LTCEncoder *e, ltcsnd_sample_t *buf) {
 	const int len = e->offset;
-	memcpy(buf, e->buf, len * sizeof(ltcsnd_sample_t) );
+	memcpy(buf, e->buf, len * e->sample_size);
 	e->offset = 0;
 	return len;
 }
 
+#define LTCCOPY_TEMPLATE(FN, FORMAT, SAMPLE_FORMAT) \
+int FN(LTCEncoder *e, FORMAT *buf) { \
+	if (e->format != SAMPLE_FORMAT) return -1; \
+	return ltc_encoder_copy_buffer(e, (ltcsnd_sample_t*) buf); \
+}
+
+LTCCOPY_TEMPLATE(ltc_encoder_copy_buffer_float, float, LTC_SAMPLE_FLOAT)
+LTCCOPY_TEMPLATE(ltc_encoder_copy_buffer_s16, short, LTC_SAMPLE_S16)
+LTCCOPY_TEMPLATE(ltc_encoder_copy_buffer_s32, int, LTC_SAMPLE_S32)
+
 int ltc_encoder_get_buffer(LTCEncoder *e, ltcsnd_sample_t *buf) {
 	return ltc_encoder_copy_buffer(e, buf);
 }
 
 void ltc_frame_set_parity(LTCFrame *frame, enum LTC_TV_STANDARD standard) {
-	int i;
-	unsigned char p = 0;
-
-	if (standard != LTC_TV_625_50) { /* 30fps, 24fps */
-		frame->biphase_mark_phase_correction = 0;
-	} else { /* 25fps */
-		frame->binary_group_flag_bit2 = 0;
-	}
-
-	for (i=0; i < LTC_FRAME_BIT_COUNT / 8; ++i){
-		p = p ^ (((unsigned char*)frame)[i]);
-	}
-#define PRY(BIT) ((p>>BIT)&1)
-
+	const unsigned char *b = (const unsigned char*)frame;
+	unsigned int p;
+
+	/* parity of all 80 bits: fold the frame into a nibble,
+	 * 0x6996 is the parity of the values 0..15.
+	 * Bytes are read individually, a wider load right after the
+	 * bit-field stores of ltc_frame_increment() would stall. */
+	p = b[0] ^ b[1] ^ b[2] ^ b[3] ^ b[4] ^ b[5] ^ b[6] ^ b[7] ^ b[8] ^ b[9];
+	p ^= p >> 4;
+	p = (0x6996 >> (p & 0x0F)) & 1;
+
+	/* the result includes the current value of the parity bit */
 	if (standard != LTC_TV_625_50) { /* 30fps, 24fps */
-		frame->biphase_mark_phase_correction =
-			PRY(0)^PRY(1)^PRY(2)^PRY(3)^PRY(4)^PRY(5)^PRY(6)^PRY(7);
+		frame->biphase_mark_phase_correction ^= p;
 	} else { /* 25fps */
-		frame->binary_group_flag_bit2 =
-			PRY(0)^PRY(1)^PRY(2)^PRY(3)^PRY(4)^PRY(5)^PRY(6)^PRY(7);
+		frame->binary_group_flag_bit2 ^= p;
 	}
 }
 
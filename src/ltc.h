@@ -94,6 +94,12 @@ typedef long long int ltc_off_t;
 
 #define LTC_FRAME_BIT_COUNT	80
 
+/**
+ * buffer size for \ref ltc_time_to_string and \ref ltc_frame_to_string,
+ * including the terminating zero
+ */
+#define LTC_TIMECODE_STRING_SIZE	12
+
 /**
  * Raw 80 bit LTC frame
  *
@@ -275,6 +281,20 @@ enum LTC_BG_FLAGS {
 	LTC_NO_PARITY = 8 ///< parity bit is left untouched when setting or in/decrementing the encoder frame-number
 };
 
+/** encoder output sample formats, see \ref ltc_encoder_set_sample_format */
+enum LTC_SAMPLE_FORMAT {
+	LTC_SAMPLE_U8 = 0, ///< unsigned 8 bit \ref ltcsnd_sample_t, 128 is the center (default)
+	LTC_SAMPLE_S16, ///< signed 16 bit (short) -32767..+32767
+	LTC_SAMPLE_S32, ///< signed 32 bit (int) full scale. 24 bit left-justified in 32 bit can use this format as well
+	LTC_SAMPLE_FLOAT ///< 32 bit float -1.0..+1.0
+};
+
+/** decoder operation flags, see \ref ltc_decoder_create_ext */
+enum LTC_DECODER_FLAGS {
+	LTC_DECODER_SPSC = 1, ///< single producer, single consumer: \ref ltc_decoder_read may be called concurrently with ltc_decoder_write from a different thread, lock-free. When the queue is full, newly decoded frames are dropped.
+	LTC_DECODER_COMPACT = 2 ///< queue \ref LTCFrameCompact records instead of \ref LTCFrameExt. No per-bit timing, volume or sample-range is collected; the queue needs about a tenth of the memory.
+};
+
 /**
  * see LTCFrame
  */
@@ -312,6 +332,23 @@ struct LTCFrameExt {
  */
 typedef struct LTCFrameExt LTCFrameExt;
 
+/**
+ * Compact decoded LTC frame, without per-bit timing information.
+ * Queued by decoders created with \ref LTC_DECODER_COMPACT.
+ * see \ref ltc_decoder_read_compact
+ */
+struct LTCFrameCompact {
+	LTCFrame ltc; ///< the actual LTC frame. see \ref LTCFrame
+	ltc_off_t off_start; ///< the approximate sample in the stream corresponding to the start of the LTC frame. see off_start of \ref LTCFrameExt
+	ltc_off_t off_end; ///< the sample in the stream corresponding to the end of the LTC frame. see off_end of \ref LTCFrameExt
+	int reverse; ///< if non-zero, a reverse played LTC frame was detected. see \ref LTCFrameExt
+};
+
+/**
+ * see \ref LTCFrameCompact
+ */
+typedef struct LTCFrameCompact LTCFrameCompact;
+
 /**
  * Human readable time representation, decimal values.
  */
@@ -339,12 +376,27 @@ typedef struct SMPTETimecode SMPTETimecode;
  */
 typedef struct LTCDecoder LTCDecoder;
 
+/**
+ * Opaque structure
+ * see: \ref ltc_decoder_bank_create, \ref ltc_decoder_bank_free
+ */
+typedef struct LTCDecoderBank LTCDecoderBank;
+
 /**
  * Opaque structure
  * see: \ref ltc_encoder_create, \ref ltc_encoder_free
  */
 typedef struct LTCEncoder LTCEncoder;
 
+/**
+ * Callback to receive decoded frames, see \ref ltc_decoder_set_frame_callback
+ *
+ * @param d the decoder that decoded the frame
+ * @param frame the decoded frame, only valid during the callback
+ * @param arg the pointer given when setting the callback
+ */
+typedef void (*ltc_decoder_frame_callback)(LTCDecoder *d, const LTCFrameExt *frame, void *arg);
+
 /**
  * Convert binary LTCFrame into SMPTETimecode struct
  *
@@ -356,6 +408,18 @@ typedef struct LTCEncoder LTCEncoder;
  */
 void ltc_frame_to_time(SMPTETimecode* stime, LTCFrame* frame, int flags);
 
+/**
+ * Convert an array of binary LTCFrames into SMPTETimecode structs.
+ * The result is the same as calling \ref ltc_frame_to_time for each
+ * frame, but the flags are only evaluated once.
+ *
+ * @param stime output, array of n_frames elements
+ * @param frames input, array of n_frames elements
+ * @param n_frames number of frames to convert
+ * @param flags binary combination of \ref LTC_BG_FLAGS - here only LTC_USE_DATE is relevant.
+ */
+void ltc_frames_to_time(SMPTETimecode* stime, LTCFrame* frames, int n_frames, int flags);
+
 /**
  * Translate SMPTETimecode struct into its binary LTC representation
  * and set the LTC frame's parity bit accordingly (see \ref ltc_frame_set_parity)
@@ -411,16 +475,168 @@ int ltc_frame_increment(LTCFrame* frame, int fps, enum LTC_TV_STANDARD standard,
  */
 int ltc_frame_decrement(LTCFrame* frame, int fps, enum LTC_TV_STANDARD standard, int flags);
 
+/**
+ * Convert the time of an LTC frame to an absolute frame number,
+ * counted from 00:00:00:00.
+ *
+ * For drop-frame timecode (frame->dfbit is set) frame numbers 0 and 1
+ * are skipped at the beginning of each minute except every 10th minute,
+ * as with \ref ltc_frame_increment. The index is continuous: consecutive
+ * frames have consecutive indices. The skipped labels themselves
+ * (e.g. 00:01:00;00) map to the index of frame 2 of that minute,
+ * as with \ref ltc_time_to_frame.
+ *
+ * @param frame the LTC-timecode to convert
+ * @param fps integer framerate (for drop-frame-timecode set frame->dfbit and round-up the fps).
+ * @return frame number 0 .. (frames per day - 1), -1 if fps is invalid
+ */
+long long ltc_frame_to_index(LTCFrame *frame, int fps);
+
+/**
+ * Convert an array of LTC frames to absolute frame numbers,
+ * see \ref ltc_frame_to_index.
+ *
+ * @param index output, array of n_frames elements, set to -1 if fps is invalid
+ * @param frames input, array of n_frames elements
+ * @param n_frames number of frames to convert
+ * @param fps integer framerate (for drop-frame-timecode set dfbit and round-up the fps).
+ */
+void ltc_frames_to_index(long long *index, LTCFrame *frames, int n_frames, int fps);
+
+/**
+ * Convert the time of a SMPTETimecode to an absolute frame number,
+ * counted from 00:00:00:00. The date is ignored.
+ * See \ref ltc_frame_to_index.
+ *
+ * @param stime the timecode to convert
+ * @param fps integer framerate (round-up for drop-frame-timecode)
+ * @param drop_frame 1 for drop-frame timecode, 0 otherwise
+ * @return frame number, -1 if fps is invalid
+ */
+long long ltc_time_to_index(SMPTETimecode *stime, int fps, int drop_frame);
+
+/**
+ * Set hours, minutes, seconds and frame of a SMPTETimecode from an
+ * absolute frame number. The index wraps around after 24h, the date and
+ * timezone are not modified.
+ * This is the inverse of \ref ltc_time_to_index.
+ *
+ * @param stime the timecode to set
+ * @param index frame number
+ * @param fps integer framerate (round-up for drop-frame-timecode)
+ * @param drop_frame 1 for drop-frame timecode, 0 otherwise
+ */
+void ltc_index_to_time(SMPTETimecode *stime, long long index, int fps, int drop_frame);
+
+/**
+ * Move the timecode by a given number of frames
+ * and set the Frame's parity bit accordingly (see \ref ltc_frame_set_parity)
+ *
+ * The result is the same as calling \ref ltc_frame_increment (or
+ * \ref ltc_frame_decrement for negative values) n_frames times,
+ * but the time needed does not depend on n_frames.
+ *
+ * @param frame the LTC-timecode to modify
+ * @param n_frames number of frames to add, may be negative
+ * @param fps integer framerate (for drop-frame-timecode set frame->dfbit and round-up the fps).
+ * @param standard the TV standard to use for parity bit assignment
+ * @param flags binary combination of \ref LTC_BG_FLAGS - here only LTC_USE_DATE and LTC_NO_PARITY are relevant.
+ * If LTC_USE_DATE is set, the user-data is interpreted as date and moved by the
+ * number of days that the timecode wraps around.
+ * @return 1 if timecode was wrapped around at 24h, 0 otherwise,
+ * -1 if fps is invalid or the date could not be parsed.
+ */
+int ltc_frame_add(LTCFrame *frame, long long n_frames, int fps, enum LTC_TV_STANDARD standard, int flags);
+
+/**
+ * Calculate the number of frames from one timecode to another.
+ *
+ * @param from the LTC-timecode to start at
+ * @param to the LTC-timecode to end at
+ * @param fps integer framerate (for drop-frame-timecode set dfbit and round-up the fps).
+ * @param flags binary combination of \ref LTC_BG_FLAGS - here only LTC_USE_DATE is relevant.
+ * If set, the user-data of both frames is interpreted as date, and the difference
+ * includes whole days. Since the year is two-digit only, the dates are
+ * assumed to be less than 50 years apart.
+ * @return number of frames: ltc_frame_add(from, result, ..) yields the time (and date) of 'to'.
+ * 0 if fps is invalid.
+ */
+long long ltc_frame_difference(LTCFrame *from, LTCFrame *to, int fps, int flags);
+
+/**
+ * Format the time of a SMPTETimecode as "HH:MM:SS:FF", or "HH:MM:SS;FF"
+ * for drop-frame timecode. The date is not included.
+ *
+ * The string does not depend on the locale, and no memory is allocated.
+ *
+ * @param buf output, at least \ref LTC_TIMECODE_STRING_SIZE bytes, zero-terminated
+ * @param stime the timecode to format
+ * @param drop_frame 1 for drop-frame timecode, 0 otherwise
+ * @return length of the string (excluding the terminating zero)
+ */
+int ltc_time_to_string(char *buf, SMPTETimecode *stime, int drop_frame);
+
+/**
+ * Format the time of an LTC frame as "HH:MM:SS:FF", or "HH:MM:SS;FF"
+ * if frame->dfbit is set. See \ref ltc_time_to_string.
+ *
+ * @param buf output, at least \ref LTC_TIMECODE_STRING_SIZE bytes, zero-terminated
+ * @param frame the LTC-timecode to format
+ * @return length of the string (excluding the terminating zero)
+ */
+int ltc_frame_to_string(char *buf, LTCFrame *frame);
+
+/**
+ * Parse a timecode string "HH:MM:SS:FF" and set hours, minutes, seconds
+ * and frame of a SMPTETimecode. A semicolon or period before the frame
+ * number ("HH:MM:SS;FF", "HH:MM:SS.FF") denotes drop-frame timecode.
+ * All fields must have exactly two digits, the string may continue with
+ * any character other than a digit. The frame number can be at most 39,
+ * the largest that fits into an LTCFrame. Drop-frame labels that do not
+ * exist (frames 00 and 01 of minutes that are not a multiple of 10) are
+ * rejected.
+ *
+ * The date and timezone are not modified, use \ref ltc_time_to_frame
+ * to convert the result to an LTCFrame.
+ *
+ * @param stime the timecode to set, not modified if the string is invalid
+ * @param str the string to parse
+ * @return 1 for drop-frame timecode, 0 for non-drop-frame timecode,
+ * -1 if the string is not a valid timecode
+ */
+int ltc_time_from_string(SMPTETimecode *stime, const char *str);
+
 /**
  * Create a new LTC decoder.
  *
  * @param apv audio-frames per video frame. This is just used for initial settings, the speed is tracked dynamically. setting this in the right ballpark is needed to properly decode the first LTC frame in a sequence.
  * @param queue_size length of the internal queue to store decoded frames
- * to SMPTEDecoderWrite.
+ * to SMPTEDecoderWrite. If the queue is full, the oldest frame is dropped.
  * @return decoder handle or NULL if out-of-memory
  */
 LTCDecoder * ltc_decoder_create(int apv, int queue_size);
 
+/**
+ * Create a new LTC decoder with options.
+ *
+ * Same as \ref ltc_decoder_create, with additional flags.
+ *
+ * By default all calls for a given decoder must be made from the same
+ * thread, or be serialized by the caller.
+ * With \ref LTC_DECODER_SPSC the decoder queue is lock-free and
+ * wait-free: one thread (e.g. the realtime audio callback) may call
+ * ltc_decoder_write and its variants, while another thread calls
+ * \ref ltc_decoder_read, \ref ltc_decoder_queue_length and
+ * \ref ltc_decoder_queue_flush.
+ *
+ * @param apv audio-frames per video frame, see \ref ltc_decoder_create
+ * @param queue_size length of the internal queue to store decoded frames
+ * @param flags binary combination of \ref LTC_DECODER_FLAGS
+ * @return decoder handle or NULL if out-of-memory, or if LTC_DECODER_SPSC
+ * is requested and libltc was built with a compiler without atomic operations
+ */
+LTCDecoder * ltc_decoder_create_ext(int apv, int queue_size, int flags);
+
 
 /**
  * Release memory of decoder.
@@ -444,8 +660,10 @@ void ltc_decoder_write(LTCDecoder *d,
 		ltc_off_t posinfo);
 
 /**
- * Wrapper around \ref ltc_decoder_write that accepts 64-bit floating point
- * audio samples. Note: internally libltc uses 8 bit only.
+ * Variant of \ref ltc_decoder_write that accepts 64-bit floating point
+ * audio samples. The samples are read in place and the signal envelope is
+ * tracked at full resolution. Only \ref LTCFrameExt sample_min, sample_max
+ * are reported using 8 bit.
  *
  * @param d decoder handle
  * @param buf pointer to audio sample data
@@ -455,8 +673,10 @@ void ltc_decoder_write(LTCDecoder *d,
 void ltc_decoder_write_double(LTCDecoder *d, double *buf, size_t size, ltc_off_t posinfo);
 
 /**
- * Wrapper around \ref ltc_decoder_write that accepts 32-bit floating point
- * audio samples. Note: internally libltc uses 8 bit only.
+ * Variant of \ref ltc_decoder_write that accepts 32-bit floating point
+ * audio samples. The samples are read in place and the signal envelope is
+ * tracked at full resolution. Only \ref LTCFrameExt sample_min, sample_max
+ * are reported using 8 bit.
  *
  * @param d decoder handle
  * @param buf pointer to audio sample data
@@ -466,8 +686,10 @@ void ltc_decoder_write_double(LTCDecoder *d, double *buf, size_t size, ltc_off_t
 void ltc_decoder_write_float(LTCDecoder *d, float *buf, size_t size, ltc_off_t posinfo);
 
 /**
- * Wrapper around \ref ltc_decoder_write that accepts signed 16 bit
- * audio samples. Note: internally libltc uses 8 bit only.
+ * Variant of \ref ltc_decoder_write that accepts signed 16 bit
+ * audio samples. The samples are read in place and the signal envelope is
+ * tracked at full resolution. Only \ref LTCFrameExt sample_min, sample_max
+ * are reported using 8 bit.
  *
  * @param d decoder handle
  * @param buf pointer to audio sample data
@@ -477,8 +699,10 @@ void ltc_decoder_write_float(LTCDecoder *d, float *buf, size_t size, ltc_off_t p
 void ltc_decoder_write_s16(LTCDecoder *d, short *buf, size_t size, ltc_off_t posinfo);
 
 /**
- * Wrapper around \ref ltc_decoder_write that accepts unsigned 16 bit
- * audio samples. Note: internally libltc uses 8 bit only.
+ * Variant of \ref ltc_decoder_write that accepts unsigned 16 bit
+ * audio samples. The samples are read in place and the signal envelope is
+ * tracked at full resolution. Only \ref LTCFrameExt sample_min, sample_max
+ * are reported using 8 bit.
  *
  * @param d decoder handle
  * @param buf pointer to audio sample data
@@ -487,6 +711,86 @@ void ltc_decoder_write_s16(LTCDecoder *d, short *buf, size_t size, ltc_off_t pos
  */
 void ltc_decoder_write_u16(LTCDecoder *d, unsigned short *buf, size_t size, ltc_off_t posinfo);
 
+/**
+ * Feed the LTC decoder with every n-th sample of a buffer.
+ *
+ * This is identical to \ref ltc_decoder_write, except that
+ * the samples are read at an interval of \p stride, which allows
+ * to decode a single channel of interleaved audio data without
+ * de-interleaving it first.
+ *
+ * @param d decoder handle
+ * @param buf pointer to the first sample of the channel to decode
+ * @param size number of samples to parse (not counting samples of other channels)
+ * @param stride distance in samples between two consecutive samples of the channel, 1 for mono. Usually the number of interleaved channels.
+ * @param posinfo (optional, recommended) sample-offset in the audio-stream.
+ */
+void ltc_decoder_write_strided(LTCDecoder *d, ltcsnd_sample_t *buf, size_t size, size_t stride, ltc_off_t posinfo);
+
+/**
+ * Variant of \ref ltc_decoder_write_strided that accepts 64-bit floating point
+ * audio samples, see also \ref ltc_decoder_write_double.
+ */
+void ltc_decoder_write_double_strided(LTCDecoder *d, double *buf, size_t size, size_t stride, ltc_off_t posinfo);
+
+/**
+ * Variant of \ref ltc_decoder_write_strided that accepts 32-bit floating point
+ * audio samples, see also \ref ltc_decoder_write_float.
+ */
+void ltc_decoder_write_float_strided(LTCDecoder *d, float *buf, size_t size, size_t stride, ltc_off_t posinfo);
+
+/**
+ * Variant of \ref ltc_decoder_write_strided that accepts signed 16 bit
+ * audio samples, see also \ref ltc_decoder_write_s16.
+ */
+void ltc_decoder_write_s16_strided(LTCDecoder *d, short *buf, size_t size, size_t stride, ltc_off_t posinfo);
+
+/**
+ * Variant of \ref ltc_decoder_write_strided that accepts unsigned 16 bit
+ * audio samples, see also \ref ltc_decoder_write_u16.
+ */
+void ltc_decoder_write_u16_strided(LTCDecoder *d, unsigned short *buf, size_t size, size_t stride, ltc_off_t posinfo);
+
+/**
+ * Decode all channels of an interleaved audio buffer.
+ *
+ * Every channel is fed to its own decoder. The buffer is processed in
+ * small blocks, all channels of a block are decoded before moving on to
+ * the next block. This is equivalent to calling \ref ltc_decoder_write_strided
+ * for each channel, but passes over the buffer only once.
+ *
+ * @param d array of \p n_channels decoder handles, NULL entries skip the given channel
+ * @param n_channels number of interleaved channels in \p buf
+ * @param buf interleaved audio data
+ * @param size number of audio-frames (samples per channel) to parse
+ * @param posinfo (optional, recommended) sample-offset in the audio-stream.
+ */
+void ltc_decoder_write_interleaved(LTCDecoder **d, int n_channels, ltcsnd_sample_t *buf, size_t size, ltc_off_t posinfo);
+
+/**
+ * Variant of \ref ltc_decoder_write_interleaved that accepts 64-bit floating point
+ * audio samples.
+ */
+void ltc_decoder_write_double_interleaved(LTCDecoder **d, int n_channels, double *buf, size_t size, ltc_off_t posinfo);
+
+/**
+ * Variant of \ref ltc_decoder_write_interleaved that accepts 32-bit floating point
+ * audio samples.
+ */
+void ltc_decoder_write_float_interleaved(LTCDecoder **d, int n_channels, float *buf, size_t size, ltc_off_t posinfo);
+
+/**
+ * Variant of \ref ltc_decoder_write_interleaved that accepts signed 16 bit
+ * audio samples.
+ */
+void ltc_decoder_write_s16_interleaved(LTCDecoder **d, int n_channels, short *buf, size_t size, ltc_off_t posinfo);
+
+/**
+ * Variant of \ref ltc_decoder_write_interleaved that accepts unsigned 16 bit
+ * audio samples.
+ */
+void ltc_decoder_write_u16_interleaved(LTCDecoder **d, int n_channels, unsigned short *buf, size_t size, ltc_off_t posinfo);
+
 /**
  * Decoded LTC frames are placed in a queue. This function retrieves
  * a frame from the queue, and stores it at LTCFrameExt*
@@ -497,6 +801,40 @@ void ltc_decoder_write_u16(LTCDecoder *d, unsigned short *buf, size_t size, ltc_
  */
 int ltc_decoder_read(LTCDecoder *d, LTCFrameExt *frame);
 
+/**
+ * Retrieve a frame from the queue without per-bit timing information.
+ *
+ * This is the counterpart of \ref ltc_decoder_read for decoders
+ * created with the \ref LTC_DECODER_COMPACT flag. Either function can be
+ * used with either kind of decoder: \ref ltc_decoder_read on a compact
+ * decoder sets biphase_tics and sample_min/max to zero and volume to
+ * -inf (not measured, as for silence), since 0 would read as 0 dBFS.
+ *
+ * @param d decoder handle
+ * @param frame the decoded LTC frame is copied there
+ * @return 1 on success or 0 when no frames queued.
+ */
+int ltc_decoder_read_compact(LTCDecoder *d, LTCFrameCompact *frame);
+
+/**
+ * Deliver decoded LTC frames directly to a callback instead of the queue.
+ *
+ * The callback is invoked as soon as a frame was decoded, from within
+ * ltc_decoder_write (or its variants) in the same thread. The frame is passed
+ * by reference, without being copied to and from the queue.
+ * While a callback is set, the queue is not used and \ref ltc_decoder_read
+ * will not return any frames.
+ *
+ * To keep the per-frame cost low, no per-bit timing is collected for
+ * the callback: biphase_tics of the frame passed to the callback are zero.
+ * All other fields are set, as with \ref ltc_decoder_read.
+ *
+ * @param d decoder handle
+ * @param cb the callback function, NULL to use the queue again
+ * @param arg pointer passed to the callback
+ */
+void ltc_decoder_set_frame_callback(LTCDecoder *d, ltc_decoder_frame_callback cb, void *arg);
+
 /**
  * Remove all LTC frames from the internal queue.
  * @param d decoder handle
@@ -510,6 +848,73 @@ void ltc_decoder_queue_flush(LTCDecoder* d);
  */
 int ltc_decoder_queue_length(LTCDecoder* d);
 
+/**
+ * Create a bank of LTC decoders to decode many channels in parallel.
+ *
+ * A decoder bank decodes all channels of an interleaved audio buffer.
+ * Compared to using one \ref LTCDecoder per channel, the per-sample
+ * state of all channels is kept together and channels are processed
+ * side by side (using SIMD instructions where available).
+ * Decoded frames are queued per channel.
+ *
+ * With SSE2, 16 channels are processed per step, remaining channels one
+ * at a time. The bank pays off from 16 channels on; for a few channels
+ * \ref ltc_decoder_write_interleaved performs about the same.
+ *
+ * @param n_channels number of channels
+ * @param apv audio-frames per video frame, see \ref ltc_decoder_create
+ * @param queue_size length of the frame queue of each channel
+ * @return decoder bank handle or NULL if out-of-memory
+ */
+LTCDecoderBank * ltc_decoder_bank_create(int n_channels, int apv, int queue_size);
+
+/**
+ * Release memory of decoder bank.
+ * @param b decoder bank handle
+ */
+int ltc_decoder_bank_free(LTCDecoderBank *b);
+
+/**
+ * Feed the decoder bank with new audio samples.
+ *
+ * @param b decoder bank handle
+ * @param buf interleaved unsigned 8 bit audio data, with the number of
+ * channels given to \ref ltc_decoder_bank_create
+ * @param size number of audio-frames (samples per channel) to parse
+ * @param posinfo (optional, recommended) sample-offset in the audio-stream, see \ref ltc_decoder_write
+ */
+void ltc_decoder_bank_write(LTCDecoderBank *b, ltcsnd_sample_t *buf, size_t size, ltc_off_t posinfo);
+
+/**
+ * Retrieve a decoded frame of the given channel, see \ref ltc_decoder_read
+ *
+ * @param b decoder bank handle
+ * @param channel channel to read 0..n_channels-1
+ * @param frame the decoded LTC frame is copied there
+ * @return 1 on success or 0 when no frames queued, -1 if the channel is invalid.
+ */
+int ltc_decoder_bank_read(LTCDecoderBank *b, int channel, LTCFrameExt *frame);
+
+/**
+ * Deliver decoded frames of the given channel to a callback,
+ * see \ref ltc_decoder_set_frame_callback
+ *
+ * @param b decoder bank handle
+ * @param channel channel 0..n_channels-1
+ * @param cb the callback function, NULL to use the queue again
+ * @param arg pointer passed to the callback
+ * @return 0 on success, -1 if the channel is invalid.
+ */
+int ltc_decoder_bank_set_frame_callback(LTCDecoderBank *b, int channel, ltc_decoder_frame_callback cb, void *arg);
+
+/**
+ * Count number of LTC frames currently in the queue of given channel.
+ * @param b decoder bank handle
+ * @param channel channel to query 0..n_channels-1
+ * @return number of queued frames, -1 if the channel is invalid.
+ */
+int ltc_decoder_bank_queue_length(LTCDecoderBank *b, int channel);
+
 
 
 /**
@@ -630,9 +1035,37 @@ int ltc_encoder_get_buffer(LTCEncoder *e, ltcsnd_sample_t *buf) DEPRECATED_EXPOR
  * to hold \ref ltc_encoder_get_buffersize bytes
  * @return the number of bytes written to the memory area
  * pointed to by buf.
+ *
+ * If a different sample format was configured with
+ * \ref ltc_encoder_set_sample_format, samples are copied in that format
+ * and the return value is the number of samples, not bytes.
  */
 int ltc_encoder_copy_buffer(LTCEncoder *e, ltcsnd_sample_t *buf);
 
+/**
+ * Variant of \ref ltc_encoder_copy_buffer for encoders that
+ * use the \ref LTC_SAMPLE_FLOAT sample format.
+ *
+ * @param e encoder handle
+ * @param buf place to store the audio-samples, needs to be large enough
+ * to hold \ref ltc_encoder_get_buffersize samples
+ * @return the number of samples written to buf, -1 if the encoder
+ * uses a different sample format.
+ */
+int ltc_encoder_copy_buffer_float(LTCEncoder *e, float *buf);
+
+/**
+ * Variant of \ref ltc_encoder_copy_buffer_float for the \ref LTC_SAMPLE_S16
+ * sample format.
+ */
+int ltc_encoder_copy_buffer_s16(LTCEncoder *e, short *buf);
+
+/**
+ * Variant of \ref ltc_encoder_copy_buffer_float for the \ref LTC_SAMPLE_S32
+ * sample format.
+ */
+int ltc_encoder_copy_buffer_s32(LTCEncoder *e, int *buf);
+
 /**
  * Retrieve a pointer to the accumulated encoded audio-data.
  *
@@ -652,6 +1085,9 @@ ltcsnd_sample_t *ltc_encoder_get_bufptr(LTCEncoder *e, int *size, int flush) DEP
  * @param buf if set, the pointer to encoder-buffer
  * @param flush call \ref ltc_encoder_buffer_flush - reset the buffer write-pointer
  * @return the number of valid bytes in the buffer
+ *
+ * With a sample format other than \ref LTC_SAMPLE_U8, the buffer holds
+ * samples of that format and the return value is the number of samples.
  */
 int ltc_encoder_get_bufferptr(LTCEncoder *e, ltcsnd_sample_t **buf, int flush);
 
@@ -669,6 +1105,9 @@ void ltc_encoder_buffer_flush(LTCEncoder *e);
  * Note this returns the total size of the buffer, not the used/free
  * part. See also \ref ltc_encoder_get_bufferptr
  *
+ * The size is given in samples, which equals bytes for the
+ * default \ref LTC_SAMPLE_U8 format.
+ *
  * @param e encoder handle
  * @return size of the allocated internal buffer.
  */
@@ -702,6 +1141,28 @@ size_t ltc_encoder_get_buffersize(LTCEncoder *e);
  */
 int ltc_encoder_reinit(LTCEncoder *e, double sample_rate, double fps, enum LTC_TV_STANDARD standard, int flags);
 
+/**
+ * Like \ref ltc_encoder_reinit but with the sample-rate and frame-rate
+ * given as exact fractions, e.g. 48000/1 and 30000/1001.
+ *
+ * The encoder counts samples with integer arithmetic, so the number
+ * of samples generated for any number of frames is exact and does not drift.
+ * \ref ltc_encoder_reinit and \ref ltc_encoder_create derive the fractions
+ * from the floating point values; frame-rates close to n*1000/1001
+ * (23.976, 29.97, 59.94,..) are taken as exactly that.
+ *
+ * @param e encoder handle
+ * @param sample_rate_num numerator of the audio sample rate
+ * @param sample_rate_den denominator of the audio sample rate
+ * @param fps_num numerator of the video-frames per second
+ * @param fps_den denominator of the video-frames per second
+ * @param standard the TV standard to use for Binary Group Flag bit position
+ * @param flags binary combination of \ref LTC_BG_FLAGS
+ * @return 0 on success, -1 if the values are out of range or the
+ * internal buffer is too small.
+ */
+int ltc_encoder_reinit_rational(LTCEncoder *e, int sample_rate_num, int sample_rate_den, int fps_num, int fps_den, enum LTC_TV_STANDARD standard, int flags);
+
 /**
  * reset ecoder state.
  * flushes buffer, reset biphase state
@@ -770,12 +1231,46 @@ double ltc_encoder_get_volume(LTCEncoder *e);
  * 0dB corresponds to a signal range of 127
  * 1..255 with 128 at the center.
  *
+ * With other sample formats (see \ref ltc_encoder_set_sample_format)
+ * the volume is not quantized and there is no lower limit.
+ *
  * @param e encoder handle
  * @param dBFS the volume in dB full-scale (<= 0.0)
  * @return 0 on success, -1 if the value was out of range
  */
 int ltc_encoder_set_volume(LTCEncoder *e, double dBFS);
 
+/**
+ * Set the sample format of the generated LTC signal.
+ *
+ * By default the encoder produces unsigned 8 bit samples
+ * (\ref LTC_SAMPLE_U8). Other formats are generated directly at full
+ * resolution, including the rise-time filter, which avoids a
+ * conversion pass and the 8 bit quantization.
+ *
+ * This re-allocates the internal buffer to hold
+ * \ref ltc_encoder_get_buffersize samples of the given format and
+ * flushes it - alike \ref ltc_encoder_buffer_flush. The volume should
+ * be set after selecting the format, since 8 bit output can not represent
+ * levels below -42dBFS.
+ *
+ * Use \ref ltc_encoder_get_bufferptr or the matching variant of
+ * \ref ltc_encoder_copy_buffer to retrieve the samples.
+ *
+ * @param e encoder handle
+ * @param format the sample format, see \ref LTC_SAMPLE_FORMAT
+ * @return 0 on success, -1 if allocation fails (the encoder remains unmodified)
+ */
+int ltc_encoder_set_sample_format(LTCEncoder *e, enum LTC_SAMPLE_FORMAT format);
+
+/**
+ * Query the sample format of the generated LTC signal.
+ *
+ * @param e encoder handle
+ * @return the sample format, see \ref LTC_SAMPLE_FORMAT
+ */
+enum LTC_SAMPLE_FORMAT ltc_encoder_get_sample_format(LTCEncoder *e);
+
 /**
  * Get encoder signal rise-time / signal filtering
  *
@@ -802,6 +1297,28 @@ double ltc_encoder_get_filter(LTCEncoder *e);
  */
 void ltc_encoder_set_filter(LTCEncoder *e, double rise_time);
 
+/**
+ * Enable or disable the encoder's waveform cache.
+ *
+ * Consecutive LTC frames differ only in a few bytes (frame number, parity).
+ * With the cache enabled, the encoder keeps the rendered samples of the
+ * last encoded value of each of the 10 bytes of a frame, and copies them
+ * instead of rendering the byte again if the value, the signal phase and
+ * the sub-sample position match.
+ *
+ * This applies to \ref ltc_encoder_encode_frame, \ref ltc_encoder_encode_reversed_frame
+ * and \ref ltc_encoder_encode_byte at speed 1.0 or -1.0. The output is identical
+ * with or without cache. It is most effective if a frame spans a whole
+ * number of samples (e.g. 48kHz at 25 fps).
+ *
+ * The cache is disabled by default and needs memory for about one frame.
+ *
+ * @param e encoder handle
+ * @param enable 1: enable, 0: disable and free the cache
+ * @return 0 on success, -1 if memory allocation failed.
+ */
+int ltc_encoder_set_waveform_cache(LTCEncoder *e, int enable);
+
 /**
  * Generate LTC audio for given byte of the LTC-frame and
  * place it into the internal buffer.
@@ -875,6 +1392,77 @@ void ltc_encoder_encode_frame(LTCEncoder *e);
  */
 void ltc_encoder_encode_reversed_frame(LTCEncoder *e);
 
+/**
+ * Render a continuous LTC stream at speed 1.0 directly into the given buffer.
+ *
+ * Unlike \ref ltc_encoder_encode_frame, this does not use the internal
+ * buffer, and the buffer can have any length, e.g. the audio period
+ * handed to a realtime callback. Frames that do not fit are continued
+ * where they left off with the next call.
+ *
+ * After a frame is completed, the timecode is incremented (as with
+ * \ref ltc_encoder_inc_timecode). Changes to the timecode should hence
+ * only be made when the previous call completed a frame exactly at the
+ * end of the buffer, or before the first call. Otherwise the
+ * remaining part of the current frame is encoded from the new data.
+ *
+ * The samples are written in the encoder's sample format, see
+ * \ref ltc_encoder_set_sample_format.
+ * \ref ltc_encoder_reset or \ref ltc_encoder_reinit restart at the
+ * beginning of a frame.
+ *
+ * @param e encoder handle
+ * @param buf buffer to write \p size samples to
+ * @param size number of samples to render
+ * @return the number of frames that were completed, -1 if buf is NULL
+ */
+int ltc_encoder_render(LTCEncoder *e, void *buf, size_t size);
+
+/**
+ * Render the given number of consecutive frames into one buffer.
+ *
+ * This is intended for offline rendering of long LTC tracks: it is
+ * equivalent to calling \ref ltc_encoder_encode_frame,
+ * \ref ltc_encoder_copy_buffer and \ref ltc_encoder_inc_timecode
+ * \p n_frames times, without the intermediate buffer and per-frame calls.
+ *
+ * The buffer needs to hold about n_frames * sample_rate / fps samples,
+ * rounded up plus one. If it is too small, rendering stops when it is full
+ * and continues with the next call to \ref ltc_encoder_render or
+ * \ref ltc_encoder_render_frames. This function shares its state
+ * with \ref ltc_encoder_render: a previously partially rendered frame is
+ * completed first and counts as one of \p n_frames.
+ *
+ * @param e encoder handle
+ * @param n_frames number of frames to render
+ * @param buf buffer to write the samples to, in the encoder's sample format
+ * @param size size of buf in samples
+ * @return number of samples written, -1 if buf is NULL or n_frames < 1
+ */
+ltc_off_t ltc_encoder_render_frames(LTCEncoder *e, int n_frames, void *buf, size_t size);
+
+/**
+ * Advance the stream of \ref ltc_encoder_render by the given number of
+ * frames without producing audio.
+ *
+ * Afterwards the encoder is in the same state as if the frames had been
+ * rendered: timecode, signal polarity and sub-sample position.
+ * This allows to split a long offline render into segments that are
+ * rendered independently, e.g. by multiple threads, each with its own
+ * encoder: the concatenated output is identical to a single render.
+ * see tests/ltcrender.c
+ *
+ * The time needed does not depend on n_frames, unless the encoder was
+ * created with LTC_NO_PARITY: the signal polarity then depends on every
+ * skipped frame. A partially rendered frame is completed first and counts
+ * as one of n_frames.
+ *
+ * @param e encoder handle
+ * @param n_frames number of frames to skip
+ * @return number of samples that the skipped frames span
+ */
+ltc_off_t ltc_encoder_skip_frames(LTCEncoder *e, int n_frames);
+
 /**
  * Set the parity of the LTC frame.
  *
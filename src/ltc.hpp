@@ -0,0 +1,255 @@
+/**
+   @file ltc.hpp
+   @brief libltc - compile-time specialized timecode for C++
+
+   Header-only C++14 companion to ltc.h: a timecode type whose TV standard
+   and drop-frame mode are template parameters, so that frame-rate and
+   drop-frame handling are resolved at compile time. All operations are
+   constexpr and can be used to compute constant timecodes at build time.
+
+   The frame numbering and drop-frame rules are the same as those of
+   ltc_frame_increment(), ltc_frame_to_index() and ltc_frame_add().
+
+   @copyright
+
+   Copyright (C) 2026 The libltc contributors
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as
+   published by the Free Software Foundation, either version 3 of the
+   License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with this library.
+   If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef LTC_HPP
+#define LTC_HPP 1
+
+#if __cplusplus < 201402L && !defined(_MSVC_LANG)
+# error "ltc.hpp requires C++14"
+#endif
+
+#include "ltc.h"
+
+namespace ltc {
+
+/**
+ * SMPTE timecode of a given TV standard, counted as frame number
+ * since 00:00:00:00. The time wraps around after 24h.
+ *
+ * Example:
+ * @code
+ * typedef ltc::Timecode<LTC_TV_525_60, true> TC2997;
+ * constexpr TC2997 start (1, 0, 0, 0);
+ * static_assert ((start + 1800).mins () == 1 && (start + 1800).frame () == 2, "drop-frame");
+ *
+ * LTCFrame frame = start.to_frame ();
+ * @endcode
+ *
+ * @tparam Standard TV standard, defines the frame-rate (24, 25 or 30 fps)
+ * and the position of the parity bit
+ * @tparam DropFrame use drop-frame timecode (30 fps only): frame numbers 0 and 1
+ * are skipped at the beginning of each minute except every 10th minute.
+ */
+template <enum LTC_TV_STANDARD Standard, bool DropFrame = false>
+class Timecode {
+public:
+	/** integer frame-rate (30 for 29.97 drop-frame) */
+	static constexpr int fps = Standard == LTC_TV_625_50 ? 25 : Standard == LTC_TV_FILM_24 ? 24 : 30;
+
+	static_assert (!DropFrame || fps == 30, "drop-frame timecode requires 30 fps");
+
+	static constexpr int drop_frames = DropFrame ? 2 : 0;
+	static constexpr long long frames_per_minute = 60 * fps - drop_frames;
+	static constexpr long long frames_per_10_minutes = 10 * 60 * fps - 9 * drop_frames;
+	static constexpr long long frames_per_day = 24 * 6 * frames_per_10_minutes;
+
+	/** 00:00:00:00 */
+	constexpr Timecode () : _index (0) {}
+
+	/**
+	 * @param hours 0..23
+	 * @param mins 0..59
+	 * @param secs 0..59
+	 * @param frame 0..fps-1, for drop-frame timecode frames 0 and 1 of
+	 * minutes that are not a multiple of 10 are moved to frame 2, as with ltc_time_to_frame()
+	 */
+	constexpr Timecode (int hours, int mins, int secs, int frame)
+		: _index (to_index (hours, mins, secs, frame))
+	{}
+
+	/** timecode of an absolute frame number, wraps around after 24h */
+	static constexpr Timecode from_index (long long index) {
+		Timecode tc;
+		tc._index = wrap (index);
+		return tc;
+	}
+
+	/** timecode of an LTC frame, the dfbit of the frame is ignored */
+	static constexpr Timecode from_frame (const LTCFrame& f) {
+		return Timecode (f.hours_units + f.hours_tens * 10, f.mins_units + f.mins_tens * 10,
+		                 f.secs_units + f.secs_tens * 10, f.frame_units + f.frame_tens * 10);
+	}
+
+	/** absolute frame number 0 .. frames_per_day - 1 */
+	constexpr long long index () const { return _index; }
+
+	constexpr int hours () const { return fields ().hours; }
+	constexpr int mins () const { return fields ().mins; }
+	constexpr int secs () const { return fields ().secs; }
+	constexpr int frame () const { return fields ().frame; }
+
+	constexpr Timecode& operator++ () {
+		_index = _index + 1 == frames_per_day ? 0 : _index + 1;
+		return *this;
+	}
+
+	constexpr Timecode& operator-- () {
+		_index = _index == 0 ? frames_per_day - 1 : _index - 1;
+		return *this;
+	}
+
+	constexpr Timecode operator++ (int) { Timecode tc (*this); ++*this; return tc; }
+	constexpr Timecode operator-- (int) { Timecode tc (*this); --*this; return tc; }
+
+	constexpr Timecode& operator+= (long long n_frames) { _index = wrap (_index + n_frames); return *this; }
+	constexpr Timecode& operator-= (long long n_frames) { _index = wrap (_index - n_frames); return *this; }
+
+	friend constexpr Timecode operator+ (Timecode tc, long long n_frames) { return tc += n_frames; }
+	friend constexpr Timecode operator- (Timecode tc, long long n_frames) { return tc -= n_frames; }
+
+	/** number of frames from b to a, within the same day */
+	friend constexpr long long operator- (const Timecode& a, const Timecode& b) { return a._index - b._index; }
+
+	friend constexpr bool operator== (const Timecode& a, const Timecode& b) { return a._index == b._index; }
+	friend constexpr bool operator!= (const Timecode& a, const Timecode& b) { return a._index != b._index; }
+	friend constexpr bool operator<  (const Timecode& a, const Timecode& b) { return a._index <  b._index; }
+	friend constexpr bool operator<= (const Timecode& a, const Timecode& b) { return a._index <= b._index; }
+	friend constexpr bool operator>  (const Timecode& a, const Timecode& b) { return a._index >  b._index; }
+	friend constexpr bool operator>= (const Timecode& a, const Timecode& b) { return a._index >= b._index; }
+
+	/**
+	 * Set the time, the dfbit and the parity bit of an LTC frame.
+	 * User-bits and the other flags are not modified.
+	 */
+	constexpr void pack (LTCFrame& f) const {
+		const Fields t = fields ();
+		f.hours_tens  = t.hours / 10;
+		f.hours_units = t.hours % 10;
+		f.mins_tens   = t.mins / 10;
+		f.mins_units  = t.mins % 10;
+		f.secs_tens   = t.secs / 10;
+		f.secs_units  = t.secs % 10;
+		f.frame_tens  = t.frame / 10;
+		f.frame_units = t.frame % 10;
+		f.dfbit = DropFrame ? 1 : 0;
+		set_parity (f);
+	}
+
+	/**
+	 * LTC frame of this timecode, as ltc_frame_reset() followed by
+	 * ltc_time_to_frame() without date.
+	 */
+	constexpr LTCFrame to_frame () const {
+		LTCFrame f {};
+#ifdef LTC_BIG_ENDIAN
+		f.sync_word = 0xFCBF;
+#else
+		f.sync_word = 0xBFFC;
+#endif
+		pack (f);
+		return f;
+	}
+
+	/** SMPTETimecode of this timecode, without date (as ltc_frame_to_time() without LTC_USE_DATE) */
+	constexpr SMPTETimecode to_time () const {
+		const Fields t = fields ();
+		SMPTETimecode st {};
+		st.timezone[0] = '+';
+		st.timezone[1] = st.timezone[2] = st.timezone[3] = st.timezone[4] = '0';
+		st.hours = t.hours;
+		st.mins  = t.mins;
+		st.secs  = t.secs;
+		st.frame = t.frame;
+		return st;
+	}
+
+private:
+	struct Fields {
+		int hours, mins, secs, frame;
+	};
+
+	static constexpr long long wrap (long long index) {
+		index %= frames_per_day;
+		return index < 0 ? index + frames_per_day : index;
+	}
+
+	static constexpr long long to_index (int hours, int mins, int secs, int frame) {
+		if (DropFrame && frame < drop_frames && secs == 0 && (mins % 10) != 0) {
+			frame = drop_frames;
+		}
+		const int total_mins = 60 * hours + mins;
+		return wrap ((3600LL * hours + 60 * mins + secs) * fps + frame
+		             - drop_frames * (total_mins - total_mins / 10));
+	}
+
+	constexpr Fields fields () const {
+		long long i = _index;
+		if (DropFrame) {
+			const long long blocks = i / frames_per_10_minutes;
+			long long rem = i % frames_per_10_minutes;
+			if (rem < drop_frames) {
+				rem = drop_frames;
+			}
+			/* add the skipped frame numbers back */
+			i += 9 * drop_frames * blocks + drop_frames * ((rem - drop_frames) / frames_per_minute);
+		}
+		Fields t {};
+		t.frame = i % fps;
+		i /= fps;
+		t.secs = i % 60;
+		i /= 60;
+		t.mins = i % 60;
+		t.hours = i / 60;
+		return t;
+	}
+
+	static constexpr unsigned int bit_parity (unsigned int v) {
+		v ^= v >> 4;
+		v ^= v >> 2;
+		v ^= v >> 1;
+		return v & 1;
+	}
+
+	/** see ltc_frame_set_parity() */
+	static constexpr void set_parity (LTCFrame& f) {
+		if (Standard != LTC_TV_625_50) {
+			f.biphase_mark_phase_correction = 0;
+		} else {
+			f.binary_group_flag_bit2 = 0;
+		}
+		const unsigned int p = bit_parity (
+			  f.frame_units ^ f.user1 ^ f.frame_tens ^ f.dfbit ^ f.col_frame ^ f.user2
+			^ f.secs_units ^ f.user3 ^ f.secs_tens ^ f.biphase_mark_phase_correction ^ f.user4
+			^ f.mins_units ^ f.user5 ^ f.mins_tens ^ f.binary_group_flag_bit0 ^ f.user6
+			^ f.hours_units ^ f.user7 ^ f.hours_tens ^ f.binary_group_flag_bit1 ^ f.binary_group_flag_bit2 ^ f.user8
+			^ (f.sync_word & 0xff) ^ (f.sync_word >> 8));
+		if (Standard != LTC_TV_625_50) {
+			f.biphase_mark_phase_correction = p;
+		} else {
+			f.binary_group_flag_bit2 = p;
+		}
+	}
+
+	long long _index;
+};
+
+} /* namespace ltc */
+
+#endif
@@ -23,128 +23,217 @@
 #include <string.h>
 
 #include "ltc.h"
+#include "compat.h"
 
 #ifdef HAVE_CONFIG_H
 # include <config.h>
 #endif
 
 /**
- * SMPTE Timezones
+ * SMPTE Timezone codes as per http://www.barney-wol.net/time/timecode.html
+ * indexed by code (user-bits 7 and 8), unused codes are empty and read as "+0000".
  */
-struct SMPTETimeZonesStruct {
-	unsigned char code; //actually 6 bit!
-	char timezone[6];
+static const char smpte_time_zones[256][6] =
+{
+    /*  code    timezone (UTC+)     //Standard time                 //Daylight saving   */
+    [0x00] = "+0000",             /* Greenwich */                 /* - */
+    [0x01] = "-0100",             /* Azores */                    /* - */
+    [0x02] = "-0200",             /* Mid-Atlantic */              /* - */
+    [0x03] = "-0300",             /* Buenos Aires */              /* Halifax */
+    [0x04] = "-0400",             /* Halifax */                   /* New York */
+    [0x05] = "-0500",             /* New York */                  /* Chicago */
+    [0x06] = "-0600",             /* Chicago Denver */            /* - */
+    [0x07] = "-0700",             /* Denver */                    /* Los Angeles */
+    [0x08] = "-0800",             /* Los Angeles */               /* - */
+    [0x09] = "-0900",             /* Alaska */                    /* - */
+    [0x10] = "-1000",             /* Hawaii */                    /* - */
+    [0x11] = "-1100",             /* Midway Island */             /* - */
+    [0x12] = "-1200",             /* Kwaialein */                 /* - */
+    [0x13] = "+1300",             /* - */                         /* New Zealand */
+    [0x14] = "+1200",             /* New Zealand */               /* - */
+    [0x15] = "+1100",             /* Solomon Islands */           /* - */
+    [0x16] = "+1000",             /* Guam */                      /* - */
+    [0x17] = "+0900",             /* Tokyo */                     /* - */
+    [0x18] = "+0800",             /* Beijing */                   /* - */
+    [0x19] = "+0700",             /* Bangkok */                   /* - */
+    [0x20] = "+0600",             /* Dhaka */                     /* - */
+    [0x21] = "+0500",             /* Islamabad */                 /* - */
+    [0x22] = "+0400",             /* Abu Dhabi */                 /* - */
+    [0x23] = "+0300",             /* Moscow */                    /* - */
+    [0x24] = "+0200",             /* Eastern Europe */            /* - */
+    [0x25] = "+0100",             /* Central Europe */            /* - */
+/*  [0x26] = "Undefined"         Reserved; do not use                                */
+/*  [0x27] = "Undefined"         Reserved; do not use                                */
+    [0x28] = "TP-03",             /* Time precision class 3 */    /* - */
+    [0x29] = "TP-02",             /* Time precision class 2 */    /* - */
+    [0x30] = "TP-01",             /* Time precision class 1 */    /* - */
+    [0x31] = "TP-00",             /* Time precision class 0 */    /* - */
+    [0x0A] = "-0030",             /* - */                         /* - */
+    [0x0B] = "-0130",             /* - */                         /* - */
+    [0x0C] = "-0230",             /* - */                         /* Newfoundland */
+    [0x0D] = "-0330",             /* Newfoundland */              /* - */
+    [0x0E] = "-0430",             /* - */                         /* - */
+    [0x0F] = "-0530",             /* - */                         /* - */
+    [0x1A] = "-0630",             /* - */                         /* - */
+    [0x1B] = "-0730",             /* - */                         /* - */
+    [0x1C] = "-0830",             /* - */                         /* - */
+    [0x1D] = "-0930",             /* Marquesa Islands */          /* - */
+    [0x1E] = "-1030",             /* - */                         /* - */
+    [0x1F] = "-1130",             /* - */                         /* - */
+    [0x2A] = "+1130",             /* Norfolk Island */            /* - */
+    [0x2B] = "+1030",             /* Lord Howe Is. */             /* - */
+    [0x2C] = "+0930",             /* Darwin */                    /* - */
+    [0x2D] = "+0830",             /* - */                         /* - */
+    [0x2E] = "+0730",             /* - */                         /* - */
+    [0x2F] = "+0630",             /* Rangoon */                   /* - */
+    [0x3A] = "+0530",             /* Bombay */                    /* - */
+    [0x3B] = "+0430",             /* Kabul */                     /* - */
+    [0x3C] = "+0330",             /* Tehran */                    /* - */
+    [0x3D] = "+0230",             /* - */                         /* - */
+    [0x3E] = "+0130",             /* - */                         /* - */
+    [0x3F] = "+0030",             /* - */                         /* - */
+    [0x32] = "+1245",             /* Chatham Island */            /* - */
+/*  [0x33] = "Undefined"         Reserved; do not use                                */
+/*  [0x34] = "Undefined"         Reserved; do not use                                */
+/*  [0x35] = "Undefined"         Reserved; do not use                                */
+/*  [0x36] = "Undefined"         Reserved; do not use                                */
+/*  [0x37] = "Undefined"         Reserved; do not use                                */
+    [0x38] = "+XXXX",             /* User defined time offset */  /* - */
+/*  [0x39] = "Undefined"         Unknown                         Unknown             */
 };
 
+/** index of a "+HHMM" or "-HHMM" offset in smpte_time_zone_codes, minutes in steps of 15 */
+#define TZ_OFFSET(sign, hours, mins) (((sign) == '-') * 14 * 4 + (hours) * 4 + (mins) / 15)
+
 /**
- * SMPTE Timezone codes as per http://www.barney-wol.net/time/timecode.html
+ * SMPTE Timezone codes by UTC offset, the reverse of smpte_time_zones.
+ * Offsets that have no code are 0x00 ("+0000").
  */
-static const struct SMPTETimeZonesStruct smpte_time_zones[] =
+static const unsigned char smpte_time_zone_codes[TZ_OFFSET('-', 14, 0)] =
 {
-    /*  code,   timezone (UTC+)     //Standard time                 //Daylight saving   */
-    {   0x00,   "+0000"             /* Greenwich */                 /* - */             },
-    {   0x00,   "-0000"             /* Greenwich */                 /* - */             },
-    {   0x01,   "-0100"             /* Azores */                    /* - */             },
-    {   0x02,   "-0200"             /* Mid-Atlantic */              /* - */             },
-    {   0x03,   "-0300"             /* Buenos Aires */              /* Halifax */       },
-    {   0x04,   "-0400"             /* Halifax */                   /* New York */      },
-    {   0x05,   "-0500"             /* New York */                  /* Chicago */       },
-    {   0x06,   "-0600"             /* Chicago Denver */            /* - */             },
-    {   0x07,   "-0700"             /* Denver */                    /* Los Angeles */   },
-    {   0x08,   "-0800"             /* Los Angeles */               /* - */             },
-    {   0x09,   "-0900"             /* Alaska */                    /* - */             },
-    {   0x10,   "-1000"             /* Hawaii */                    /* - */             },
-    {   0x11,   "-1100"             /* Midway Island */             /* - */             },
-    {   0x12,   "-1200"             /* Kwaialein */                 /* - */             },
-    {   0x13,   "+1300"             /* - */                         /* New Zealand */   },
-    {   0x14,   "+1200"             /* New Zealand */               /* - */             },
-    {   0x15,   "+1100"             /* Solomon Islands */           /* - */             },
-    {   0x16,   "+1000"             /* Guam */                      /* - */             },
-    {   0x17,   "+0900"             /* Tokyo */                     /* - */             },
-    {   0x18,   "+0800"             /* Beijing */                   /* - */             },
-    {   0x19,   "+0700"             /* Bangkok */                   /* - */             },
-    {   0x20,   "+0600"             /* Dhaka */                     /* - */             },
-    {   0x21,   "+0500"             /* Islamabad */                 /* - */             },
-    {   0x22,   "+0400"             /* Abu Dhabi */                 /* - */             },
-    {   0x23,   "+0300"             /* Moscow */                    /* - */             },
-    {   0x24,   "+0200"             /* Eastern Europe */            /* - */             },
-    {   0x25,   "+0100"             /* Central Europe */            /* - */             },
-/*  {   0x26,   "Undefined"         Reserved; do not use                                },*/
-/*  {   0x27,   "Undefined"         Reserved; do not use                                },*/
-    {   0x28,   "TP-03"             /* Time precision class 3 */    /* - */             },
-    {   0x29,   "TP-02"             /* Time precision class 2 */    /* - */             },
-    {   0x30,   "TP-01"             /* Time precision class 1 */    /* - */             },
-    {   0x31,   "TP-00"             /* Time precision class 0 */    /* - */             },
-    {   0x0A,   "-0030"             /* - */                         /* - */             },
-    {   0x0B,   "-0130"             /* - */                         /* - */             },
-    {   0x0C,   "-0230"             /* - */                         /* Newfoundland */  },
-    {   0x0D,   "-0330"             /* Newfoundland */              /* - */             },
-    {   0x0E,   "-0430"             /* - */                         /* - */             },
-    {   0x0F,   "-0530"             /* - */                         /* - */             },
-    {   0x1A,   "-0630"             /* - */                         /* - */             },
-    {   0x1B,   "-0730"             /* - */                         /* - */             },
-    {   0x1C,   "-0830"             /* - */                         /* - */             },
-    {   0x1D,   "-0930"             /* Marquesa Islands */          /* - */             },
-    {   0x1E,   "-1030"             /* - */                         /* - */             },
-    {   0x1F,   "-1130"             /* - */                         /* - */             },
-    {   0x2A,   "+1130"             /* Norfolk Island */            /* - */             },
-    {   0x2B,   "+1030"             /* Lord Howe Is. */             /* - */             },
-    {   0x2C,   "+0930"             /* Darwin */                    /* - */             },
-    {   0x2D,   "+0830"             /* - */                         /* - */             },
-    {   0x2E,   "+0730"             /* - */                         /* - */             },
-    {   0x2F,   "+0630"             /* Rangoon */                   /* - */             },
-    {   0x3A,   "+0530"             /* Bombay */                    /* - */             },
-    {   0x3B,   "+0430"             /* Kabul */                     /* - */             },
-    {   0x3C,   "+0330"             /* Tehran */                    /* - */             },
-    {   0x3D,   "+0230"             /* - */                         /* - */             },
-    {   0x3E,   "+0130"             /* - */                         /* - */             },
-    {   0x3F,   "+0030"             /* - */                         /* - */             },
-    {   0x32,   "+1245"             /* Chatham Island */            /* - */             },
-/*  {   0x33,   "Undefined"         Reserved; do not use                                },*/
-/*  {   0x34,   "Undefined"         Reserved; do not use                                },*/
-/*  {   0x35,   "Undefined"         Reserved; do not use                                },*/
-/*  {   0x36,   "Undefined"         Reserved; do not use                                },*/
-/*  {   0x37,   "Undefined"         Reserved; do not use                                },*/
-    {   0x38,   "+XXXX"             /* User defined time offset */  /* - */             },
-/*  {   0x39,   "Undefined"         Unknown                         Unknown             },*/
-/*  {   0x39,   "Undefined"         Unknown                         Unknown             },*/
-
-    {   0xFF,   ""                  /* The End */                                       }
+    [TZ_OFFSET('+', 0, 0)] = 0x00, /* +0000 */
+    [TZ_OFFSET('-', 0, 0)] = 0x00, /* -0000 */
+    [TZ_OFFSET('-', 1, 0)] = 0x01, /* -0100 */
+    [TZ_OFFSET('-', 2, 0)] = 0x02, /* -0200 */
+    [TZ_OFFSET('-', 3, 0)] = 0x03, /* -0300 */
+    [TZ_OFFSET('-', 4, 0)] = 0x04, /* -0400 */
+    [TZ_OFFSET('-', 5, 0)] = 0x05, /* -0500 */
+    [TZ_OFFSET('-', 6, 0)] = 0x06, /* -0600 */
+    [TZ_OFFSET('-', 7, 0)] = 0x07, /* -0700 */
+    [TZ_OFFSET('-', 8, 0)] = 0x08, /* -0800 */
+    [TZ_OFFSET('-', 9, 0)] = 0x09, /* -0900 */
+    [TZ_OFFSET('-', 10, 0)] = 0x10, /* -1000 */
+    [TZ_OFFSET('-', 11, 0)] = 0x11, /* -1100 */
+    [TZ_OFFSET('-', 12, 0)] = 0x12, /* -1200 */
+    [TZ_OFFSET('+', 13, 0)] = 0x13, /* +1300 */
+    [TZ_OFFSET('+', 12, 0)] = 0x14, /* +1200 */
+    [TZ_OFFSET('+', 11, 0)] = 0x15, /* +1100 */
+    [TZ_OFFSET('+', 10, 0)] = 0x16, /* +1000 */
+    [TZ_OFFSET('+', 9, 0)] = 0x17, /* +0900 */
+    [TZ_OFFSET('+', 8, 0)] = 0x18, /* +0800 */
+    [TZ_OFFSET('+', 7, 0)] = 0x19, /* +0700 */
+    [TZ_OFFSET('+', 6, 0)] = 0x20, /* +0600 */
+    [TZ_OFFSET('+', 5, 0)] = 0x21, /* +0500 */
+    [TZ_OFFSET('+', 4, 0)] = 0x22, /* +0400 */
+    [TZ_OFFSET('+', 3, 0)] = 0x23, /* +0300 */
+    [TZ_OFFSET('+', 2, 0)] = 0x24, /* +0200 */
+    [TZ_OFFSET('+', 1, 0)] = 0x25, /* +0100 */
+    [TZ_OFFSET('-', 0, 30)] = 0x0A, /* -0030 */
+    [TZ_OFFSET('-', 1, 30)] = 0x0B, /* -0130 */
+    [TZ_OFFSET('-', 2, 30)] = 0x0C, /* -0230 */
+    [TZ_OFFSET('-', 3, 30)] = 0x0D, /* -0330 */
+    [TZ_OFFSET('-', 4, 30)] = 0x0E, /* -0430 */
+    [TZ_OFFSET('-', 5, 30)] = 0x0F, /* -0530 */
+    [TZ_OFFSET('-', 6, 30)] = 0x1A, /* -0630 */
+    [TZ_OFFSET('-', 7, 30)] = 0x1B, /* -0730 */
+    [TZ_OFFSET('-', 8, 30)] = 0x1C, /* -0830 */
+    [TZ_OFFSET('-', 9, 30)] = 0x1D, /* -0930 */
+    [TZ_OFFSET('-', 10, 30)] = 0x1E, /* -1030 */
+    [TZ_OFFSET('-', 11, 30)] = 0x1F, /* -1130 */
+    [TZ_OFFSET('+', 11, 30)] = 0x2A, /* +1130 */
+    [TZ_OFFSET('+', 10, 30)] = 0x2B, /* +1030 */
+    [TZ_OFFSET('+', 9, 30)] = 0x2C, /* +0930 */
+    [TZ_OFFSET('+', 8, 30)] = 0x2D, /* +0830 */
+    [TZ_OFFSET('+', 7, 30)] = 0x2E, /* +0730 */
+    [TZ_OFFSET('+', 6, 30)] = 0x2F, /* +0630 */
+    [TZ_OFFSET('+', 5, 30)] = 0x3A, /* +0530 */
+    [TZ_OFFSET('+', 4, 30)] = 0x3B, /* +0430 */
+    [TZ_OFFSET('+', 3, 30)] = 0x3C, /* +0330 */
+    [TZ_OFFSET('+', 2, 30)] = 0x3D, /* +0230 */
+    [TZ_OFFSET('+', 1, 30)] = 0x3E, /* +0130 */
+    [TZ_OFFSET('+', 0, 30)] = 0x3F, /* +0030 */
+    [TZ_OFFSET('+', 12, 45)] = 0x32, /* +1245 */
 };
 
-static void smpte_set_timezone_string(LTCFrame *frame, SMPTETimecode *stime) {
-	int i = 0;
+/** SMPTE Timezone codes of "TP-00" .. "TP-03" */
+static const unsigned char smpte_time_precision_codes[4] = { 0x31, 0x30, 0x29, 0x28 };
 
+static void smpte_set_timezone_string(LTCFrame *frame, SMPTETimecode *stime) {
 	const unsigned char code = frame->user7 + (frame->user8 << 4);
+	const char *timezone = smpte_time_zones[code];
 
-	char timezone[6] = "+0000";
+	memcpy(stime->timezone, timezone[0] ? timezone : "+0000", sizeof(stime->timezone));
+}
 
-	for (i = 0 ; smpte_time_zones[i].code != 0xFF ; i++) {
-		if ( smpte_time_zones[i].code == code ) {
-			strcpy(timezone, smpte_time_zones[i].timezone);
-			break;
-		}
+/**
+ * look up the code of a timezone string
+ * @return code, 0x00 if the timezone has no code
+ */
+static unsigned char smpte_timezone_code(const char *tz) {
+	int hours, mins;
+
+	if (tz[0] == 'T' && tz[1] == 'P' && tz[2] == '-' && tz[3] == '0' && tz[4] >= '0' && tz[4] <= '3' && tz[5] == '\0') {
+		return smpte_time_precision_codes[tz[4] - '0'];
+	}
+	if (tz[0] != '+' && tz[0] != '-') {
+		return 0x00;
+	}
+	if (tz[0] == '+' && tz[1] == 'X' && tz[2] == 'X' && tz[3] == 'X' && tz[4] == 'X' && tz[5] == '\0') {
+		return 0x38;
+	}
+	if ((unsigned) (tz[1] - '0') > 9 || (unsigned) (tz[2] - '0') > 9
+			|| (unsigned) (tz[3] - '0') > 9 || (unsigned) (tz[4] - '0') > 9 || tz[5] != '\0') {
+		return 0x00;
 	}
-	strcpy(stime->timezone, timezone);
+
+	hours = (tz[1] - '0') * 10 + (tz[2] - '0');
+	mins  = (tz[3] - '0') * 10 + (tz[4] - '0');
+	if (hours > 13 || (mins % 15) != 0 || mins > 45) {
+		return 0x00;
+	}
+	return smpte_time_zone_codes[TZ_OFFSET(tz[0], hours, mins)];
 }
 
 static void smpte_set_timezone_code(SMPTETimecode *stime, LTCFrame *frame) {
-	int i = 0;
-	unsigned char code = 0x00;
-
-	// Find code for timezone string
-	// Primitive search
-	for (i=0; smpte_time_zones[i].code != 0xFF; i++) {
-		if ( (strcmp(smpte_time_zones[i].timezone, stime->timezone)) == 0 ) {
-			code = smpte_time_zones[i].code;
-			break;
-		}
-	}
+	const unsigned char code = smpte_timezone_code(stime->timezone);
 
 	frame->user7 = code & 0x0F;
 	frame->user8 = (code & 0xF0) >> 4;
 }
 
+#define BCD_ROW(t) \
+	(t)<<4, (t)<<4|1, (t)<<4|2, (t)<<4|3, (t)<<4|4, (t)<<4|5, (t)<<4|6, (t)<<4|7, (t)<<4|8, (t)<<4|9
+
+/** 0..99 to BCD, tens in the upper and units in the lower nibble */
+static const unsigned char bcd_table[100] = { BCD_ROW(0), BCD_ROW(1), BCD_ROW(2), BCD_ROW(3), BCD_ROW(4), BCD_ROW(5), BCD_ROW(6), BCD_ROW(7), BCD_ROW(8), BCD_ROW(9) };
+
+#undef BCD_ROW
+
+static inline unsigned char to_bcd(int v) {
+	return (unsigned) v < 100 ? bcd_table[v] : ((v / 10) << 4) | (v % 10);
+}
+
+/** set a pair of BCD tens and units bit-fields */
+#define SET_BCD(tens, units, value) \
+	do { const unsigned char bcd_ = to_bcd(value); (tens) = bcd_ >> 4; (units) = bcd_ & 0x0F; } while (0)
+
+/** store the date in the user-bits */
+static inline void frame_set_date(LTCFrame *frame, int years, int months, int days) {
+	SET_BCD(frame->user6, frame->user5, years);
+	SET_BCD(frame->user4, frame->user3, months);
+	SET_BCD(frame->user2, frame->user1, days);
+}
+
 /** Drop-frame support function
  * We skip the first two frame numbers (0 and 1) at the beginning of each minute,
  * except for minutes 0, 10, 20, 30, 40, and 50
@@ -161,47 +250,103 @@ static void skip_drop_frames(LTCFrame* frame) {
 	}
 }
 
+#ifndef LTC_BIG_ENDIAN
+/* The first 64 bits of the frame hold four 16 bit lanes (frame, secs,
+ * mins, hours), each with the BCD units in bits 0-3, the user-bits in
+ * 4-7 and 12-15 and the BCD tens in bits 8-10. All four lanes are
+ * decoded with a single multiply-add, the result fits in the lowest
+ * byte of each lane.
+ */
+#define BCD_UNITS 0x000F000F000F000FULL
+#define BCD_TENS  0x0003000700070003ULL /* frame and hours tens are 2 bits */
+
+static inline unsigned long long frame_word(const LTCFrame *frame) {
+	unsigned long long w;
+	memcpy(&w, frame, sizeof(w));
+	return w;
+}
+#endif
+
+static inline void frame_to_time(SMPTETimecode *stime, const LTCFrame *frame) {
+#ifndef LTC_BIG_ENDIAN
+	const unsigned long long w = frame_word(frame);
+	const unsigned long long v = (w & BCD_UNITS) + ((w >> 8) & BCD_TENS) * 10;
+	stime->frame = v;
+	stime->secs  = v >> 16;
+	stime->mins  = v >> 32;
+	stime->hours = v >> 48;
+#else
+	stime->hours = frame->hours_units + frame->hours_tens*10;
+	stime->mins  = frame->mins_units  + frame->mins_tens*10;
+	stime->secs  = frame->secs_units  + frame->secs_tens*10;
+	stime->frame = frame->frame_units + frame->frame_tens*10;
+#endif
+}
+
+static inline void frame_to_date(SMPTETimecode *stime, LTCFrame *frame) {
+	smpte_set_timezone_string(frame, stime);
+
+#ifndef LTC_BIG_ENDIAN
+	{
+		/* user1,3,5 are BCD units, user2,4,6 tens of days, months, years */
+		const unsigned long long w = frame_word(frame);
+		const unsigned long long v = ((w >> 4) & BCD_UNITS) + ((w >> 12) & BCD_UNITS) * 10;
+		stime->days   = v;
+		stime->months = v >> 16;
+		stime->years  = v >> 32;
+	}
+#else
+	stime->years  = frame->user5 + frame->user6*10;
+	stime->months = frame->user3 + frame->user4*10;
+	stime->days   = frame->user1 + frame->user2*10;
+#endif
+}
+
+static inline void clear_date(SMPTETimecode *stime) {
+	stime->years  = 0;
+	stime->months = 0;
+	stime->days   = 0;
+	memcpy(stime->timezone, "+0000", sizeof(stime->timezone));
+}
+
 void ltc_frame_to_time(SMPTETimecode *stime, LTCFrame *frame, int flags) {
 	if (!stime) return;
 
 	if (flags & LTC_USE_DATE) {
-		smpte_set_timezone_string(frame, stime);
-
-		stime->years  = frame->user5 + frame->user6*10;
-		stime->months = frame->user3 + frame->user4*10;
-		stime->days   = frame->user1 + frame->user2*10;
+		frame_to_date(stime, frame);
 	} else {
-		stime->years  = 0;
-		stime->months = 0;
-		stime->days   = 0;
-		sprintf(stime->timezone,"+0000");
+		clear_date(stime);
 	}
+	frame_to_time(stime, frame);
+}
 
-	stime->hours = frame->hours_units + frame->hours_tens*10;
-	stime->mins  = frame->mins_units  + frame->mins_tens*10;
-	stime->secs  = frame->secs_units  + frame->secs_tens*10;
-	stime->frame = frame->frame_units + frame->frame_tens*10;
+void ltc_frames_to_time(SMPTETimecode *stime, LTCFrame *frames, int n_frames, int flags) {
+	int i;
+	if (!stime || !frames) return;
+
+	if (flags & LTC_USE_DATE) {
+		for (i = 0; i < n_frames; ++i) {
+			frame_to_date(&stime[i], &frames[i]);
+			frame_to_time(&stime[i], &frames[i]);
+		}
+	} else {
+		for (i = 0; i < n_frames; ++i) {
+			clear_date(&stime[i]);
+			frame_to_time(&stime[i], &frames[i]);
+		}
+	}
 }
 
 void ltc_time_to_frame(LTCFrame* frame, SMPTETimecode* stime, enum LTC_TV_STANDARD standard, int flags) {
 	if (flags & LTC_USE_DATE) {
 		smpte_set_timezone_code(stime, frame);
-		frame->user6 = stime->years/10;
-		frame->user5 = stime->years - frame->user6*10;
-		frame->user4 = stime->months/10;
-		frame->user3 = stime->months - frame->user4*10;
-		frame->user2 = stime->days/10;
-		frame->user1 = stime->days - frame->user2*10;
-	}
-
-	frame->hours_tens  = stime->hours/10;
-	frame->hours_units = stime->hours - frame->hours_tens*10;
-	frame->mins_tens   = stime->mins/10;
-	frame->mins_units  = stime->mins - frame->mins_tens*10;
-	frame->secs_tens   = stime->secs/10;
-	frame->secs_units  = stime->secs - frame->secs_tens*10;
-	frame->frame_tens  = stime->frame/10;
-	frame->frame_units = stime->frame - frame->frame_tens*10;
+		frame_set_date(frame, stime->years, stime->months, stime->days);
+	}
+
+	SET_BCD(frame->hours_tens, frame->hours_units, stime->hours);
+	SET_BCD(frame->mins_tens,  frame->mins_units,  stime->mins);
+	SET_BCD(frame->secs_tens,  frame->secs_units,  stime->secs);
+	SET_BCD(frame->frame_tens, frame->frame_units, stime->frame);
 
 	// Prevent illegal SMPTE frames
 	if (frame->dfbit) {
@@ -295,12 +440,7 @@ int ltc_frame_increment(LTCFrame* frame, int fps, enum LTC_TV_STANDARD standard,
 											stime.years=(stime.years+1)%100;
 										}
 									}
-									frame->user6 = stime.years/10;
-									frame->user5 = stime.years%10;
-									frame->user4 = stime.months/10;
-									frame->user3 = stime.months%10;
-									frame->user2 = stime.days/10;
-									frame->user1 = stime.days%10;
+									frame_set_date(frame, stime.years, stime.months, stime.days);
 								} else {
 									rv=-1;
 								}
@@ -333,8 +473,7 @@ int ltc_frame_decrement(LTCFrame* frame, int fps, enum LTC_TV_STANDARD standard,
 		frames = fps -1;
 	}
 
-	frame->frame_units = frames % 10;
-	frame->frame_tens  = frames / 10;
+	SET_BCD(frame->frame_tens, frame->frame_units, frames);
 
 	if (frames == fps -1) {
 		int secs = frame->secs_units + frame->secs_tens * 10;
@@ -343,8 +482,7 @@ int ltc_frame_decrement(LTCFrame* frame, int fps, enum LTC_TV_STANDARD standard,
 		} else {
 			secs = 59;
 		}
-		frame->secs_units = secs % 10;
-		frame->secs_tens  = secs / 10;
+		SET_BCD(frame->secs_tens, frame->secs_units, secs);
 
 		if (secs == 59) {
 			int mins = frame->mins_units + frame->mins_tens * 10;
@@ -353,8 +491,7 @@ int ltc_frame_decrement(LTCFrame* frame, int fps, enum LTC_TV_STANDARD standard,
 			} else {
 				mins = 59;
 			}
-			frame->mins_units = mins % 10;
-			frame->mins_tens  = mins / 10;
+			SET_BCD(frame->mins_tens, frame->mins_units, mins);
 
 			if (mins == 59) {
 				int hours = frame->hours_units + frame->hours_tens * 10;
@@ -363,8 +500,7 @@ int ltc_frame_decrement(LTCFrame* frame, int fps, enum LTC_TV_STANDARD standard,
 				} else {
 					hours = 23;
 				}
-				frame->hours_units = hours % 10;
-				frame->hours_tens  = hours / 10;
+				SET_BCD(frame->hours_tens, frame->hours_units, hours);
 
 				if (hours == 23) {
 					/* 24h wrap around */
@@ -397,12 +533,7 @@ int ltc_frame_decrement(LTCFrame* frame, int fps, enum LTC_TV_STANDARD standard,
 								}
 							}
 
-							frame->user6 = stime.years/10;
-							frame->user5 = stime.years%10;
-							frame->user4 = stime.months/10;
-							frame->user3 = stime.months%10;
-							frame->user2 = stime.days/10;
-							frame->user1 = stime.days%10;
+							frame_set_date(frame, stime.years, stime.months, stime.days);
 						} else {
 							rv=-1;
 						}
@@ -431,6 +562,306 @@ int ltc_frame_decrement(LTCFrame* frame, int fps, enum LTC_TV_STANDARD standard,
 	return rv;
 }
 
+/* -+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+ * Frame index arithmetic
+ *
+ * Drop-frame timecode skips frame numbers 0 and 1 at the beginning of each
+ * minute, except for every 10th minute, same as ltc_frame_increment().
+ */
+
+#define DROP_FRAMES 2
+
+static long long frames_per_day(int fps, int drop_frame) {
+	return 24LL * 6 * (10 * 60 * fps - (drop_frame ? 9 * DROP_FRAMES : 0));
+}
+
+/** labels that do not exist in drop-frame timecode are moved to frame 2, as with skip_drop_frames() */
+static inline long long index_from_fields(int fps, int drop_frame, int hours, int mins, int secs, int frame) {
+	const int total_mins = 60 * hours + mins;
+	long long index;
+	if (drop_frame && frame < DROP_FRAMES && secs == 0 && mins % 10 != 0) {
+		frame = DROP_FRAMES;
+	}
+	index = (3600LL * hours + 60 * mins + secs) * fps + frame;
+	if (drop_frame) {
+		index -= DROP_FRAMES * (total_mins - total_mins / 10);
+	}
+	return index;
+}
+
+/** index must be 0 <= index < frames_per_day() */
+static void fields_from_index(long long index, int fps, int drop_frame, int *hours, int *mins, int *secs, int *frame) {
+	if (drop_frame) {
+		const long long per_10min = 10 * 60 * fps - 9 * DROP_FRAMES;
+		const long long per_min = 60 * fps - DROP_FRAMES;
+		const long long blocks = index / per_10min;
+		long long rem = index % per_10min;
+		if (rem < DROP_FRAMES) {
+			rem = DROP_FRAMES;
+		}
+		/* add the skipped frame numbers back */
+		index += 9 * DROP_FRAMES * blocks + DROP_FRAMES * ((rem - DROP_FRAMES) / per_min);
+	}
+	*frame = index % fps;
+	index /= fps;
+	*secs = index % 60;
+	index /= 60;
+	*mins = index % 60;
+	*hours = index / 60;
+}
+
+static const unsigned short days_before_month[12] = {0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334};
+
+/** days per 100 years, every 4th year is a leap year (see ltc_frame_increment) */
+#define DAYS_PER_CENTURY (100 * 365 + 25)
+
+/** days since 1st of January year 00 */
+static long date_to_days(int years, int months, int days) {
+	long n = years * 365L + (years + 3) / 4 + days_before_month[months - 1] + days - 1;
+	if (months > 2 && (years % 4) == 0) {
+		++n;
+	}
+	return n;
+}
+
+static void days_to_date(long n, int *years, int *months, int *days) {
+	int leap;
+	int m;
+
+	n %= DAYS_PER_CENTURY;
+	if (n < 0) {
+		n += DAYS_PER_CENTURY;
+	}
+
+	*years = 4 * (n / 1461);
+	n %= 1461;
+	if (n >= 366) {
+		n -= 366;
+		*years += 1 + n / 365;
+		n %= 365;
+	}
+
+	leap = (*years % 4) == 0;
+	for (m = 11; m > 0; --m) {
+		if (n >= days_before_month[m] + (leap && m > 1 ? 1 : 0)) {
+			break;
+		}
+	}
+	*months = m + 1;
+	*days = n - days_before_month[m] - (leap && m > 1 ? 1 : 0) + 1;
+}
+
+long long ltc_time_to_index(SMPTETimecode *stime, int fps, int drop_frame) {
+	if (fps < 1) return -1;
+	return index_from_fields(fps, drop_frame, stime->hours, stime->mins, stime->secs, stime->frame);
+}
+
+void ltc_index_to_time(SMPTETimecode *stime, long long index, int fps, int drop_frame) {
+	int hours, mins, secs, frame;
+	long long fpd;
+
+	if (fps < 1) return;
+
+	fpd = frames_per_day(fps, drop_frame);
+	index %= fpd;
+	if (index < 0) {
+		index += fpd;
+	}
+
+	fields_from_index(index, fps, drop_frame, &hours, &mins, &secs, &frame);
+	stime->hours = hours;
+	stime->mins  = mins;
+	stime->secs  = secs;
+	stime->frame = frame;
+}
+
+long long ltc_frame_to_index(LTCFrame *frame, int fps) {
+	if (fps < 1) return -1;
+	return index_from_fields(fps, frame->dfbit,
+			frame->hours_units + frame->hours_tens * 10,
+			frame->mins_units  + frame->mins_tens * 10,
+			frame->secs_units  + frame->secs_tens * 10,
+			frame->frame_units + frame->frame_tens * 10);
+}
+
+void ltc_frames_to_index(long long *index, LTCFrame *frames, int n_frames, int fps) {
+	int i;
+	if (!index || !frames) return;
+
+	if (fps < 1) {
+		for (i = 0; i < n_frames; ++i) {
+			index[i] = -1;
+		}
+		return;
+	}
+
+	for (i = 0; i < n_frames; ++i) {
+		const LTCFrame *f = &frames[i];
+		index[i] = index_from_fields(fps, f->dfbit,
+				f->hours_units + f->hours_tens * 10,
+				f->mins_units  + f->mins_tens * 10,
+				f->secs_units  + f->secs_tens * 10,
+				f->frame_units + f->frame_tens * 10);
+	}
+}
+
+int ltc_frame_add(LTCFrame *frame, long long n_frames, int fps, enum LTC_TV_STANDARD standard, int flags) {
+	int rv = 0;
+	int hours, mins, secs, frm;
+	long long fpd, index, days;
+
+	if (fps < 1) return -1;
+
+	fpd = frames_per_day(fps, frame->dfbit);
+	index = ltc_frame_to_index(frame, fps) + n_frames;
+
+	days = index / fpd;
+	index %= fpd;
+	if (index < 0) {
+		index += fpd;
+		--days;
+	}
+
+	if (days != 0) {
+		/* 24h wrap around */
+		rv = 1;
+		if (flags & LTC_USE_DATE) {
+			/* wrap date */
+			int years  = frame->user5 + frame->user6 * 10;
+			int months = frame->user3 + frame->user4 * 10;
+			int mdays  = frame->user1 + frame->user2 * 10;
+
+			if (months > 0 && months < 13) {
+				days_to_date(date_to_days(years, months, mdays) + (long) (days % DAYS_PER_CENTURY), &years, &months, &mdays);
+				frame_set_date(frame, years, months, mdays);
+			} else {
+				rv = -1;
+			}
+		}
+	}
+
+	fields_from_index(index, fps, frame->dfbit, &hours, &mins, &secs, &frm);
+	SET_BCD(frame->hours_tens, frame->hours_units, hours);
+	SET_BCD(frame->mins_tens,  frame->mins_units,  mins);
+	SET_BCD(frame->secs_tens,  frame->secs_units,  secs);
+	SET_BCD(frame->frame_tens, frame->frame_units, frm);
+
+	if ((flags & LTC_NO_PARITY) == 0) {
+		ltc_frame_set_parity(frame, standard);
+	}
+
+	return rv;
+}
+
+long long ltc_frame_difference(LTCFrame *from, LTCFrame *to, int fps, int flags) {
+	long long diff;
+
+	if (fps < 1) return 0;
+
+	diff = ltc_frame_to_index(to, fps) - ltc_frame_to_index(from, fps);
+
+	if (flags & LTC_USE_DATE) {
+		const int from_months = from->user3 + from->user4 * 10;
+		const int to_months   = to->user3 + to->user4 * 10;
+		if (from_months > 0 && from_months < 13 && to_months > 0 && to_months < 13) {
+			long days =
+				date_to_days(to->user5 + to->user6 * 10, to_months, to->user1 + to->user2 * 10)
+				- date_to_days(from->user5 + from->user6 * 10, from_months, from->user1 + from->user2 * 10);
+			/* 2-digit years wrap around, use the nearest */
+			if (days > DAYS_PER_CENTURY / 2) {
+				days -= DAYS_PER_CENTURY;
+			} else if (days < -DAYS_PER_CENTURY / 2) {
+				days += DAYS_PER_CENTURY;
+			}
+			diff += days * frames_per_day(fps, to->dfbit);
+		}
+	}
+	return diff;
+}
+
+#define DIGIT_ROW(t) #t "0" #t "1" #t "2" #t "3" #t "4" #t "5" #t "6" #t "7" #t "8" #t "9"
+
+/** decimal representation of 0..99, two characters each */
+static const char digit_pairs[200] = DIGIT_ROW(0) DIGIT_ROW(1) DIGIT_ROW(2) DIGIT_ROW(3) DIGIT_ROW(4) DIGIT_ROW(5) DIGIT_ROW(6) DIGIT_ROW(7) DIGIT_ROW(8) DIGIT_ROW(9);
+
+#undef DIGIT_ROW
+
+static inline void put_digits(char *buf, unsigned int v) {
+	memcpy(buf, &digit_pairs[2 * (v % 100)], 2);
+}
+
+static inline void time_to_string(char *buf, int hours, int mins, int secs, int frame, int drop_frame) {
+	put_digits(buf, hours);
+	buf[2] = ':';
+	put_digits(buf + 3, mins);
+	buf[5] = ':';
+	put_digits(buf + 6, secs);
+	buf[8] = drop_frame ? ';' : ':';
+	put_digits(buf + 9, frame);
+	buf[11] = '\0';
+}
+
+/* value of two decimal digits, -1 if s does not start with two digits.
+ * s[1] is not read if s[0] is the terminating zero. */
+static inline int parse_digits(const char *s) {
+	const unsigned int tens = (unsigned char)s[0] - '0';
+	unsigned int units;
+	if (tens > 9) return -1;
+	units = (unsigned char)s[1] - '0';
+	if (units > 9) return -1;
+	return tens * 10 + units;
+}
+
+int ltc_time_to_string(char *buf, SMPTETimecode *stime, int drop_frame) {
+	time_to_string(buf, stime->hours, stime->mins, stime->secs, stime->frame, drop_frame);
+	return LTC_TIMECODE_STRING_SIZE - 1;
+}
+
+int ltc_frame_to_string(char *buf, LTCFrame *frame) {
+	time_to_string(buf,
+			frame->hours_units + frame->hours_tens * 10,
+			frame->mins_units  + frame->mins_tens  * 10,
+			frame->secs_units  + frame->secs_tens  * 10,
+			frame->frame_units + frame->frame_tens * 10,
+			frame->dfbit);
+	return LTC_TIMECODE_STRING_SIZE - 1;
+}
+
+int ltc_time_from_string(SMPTETimecode *stime, const char *str) {
+	int hours, mins, secs, frame, drop_frame;
+
+	hours = parse_digits(str);
+	if (hours < 0 || hours > 23 || str[2] != ':') return -1;
+	mins = parse_digits(str + 3);
+	if (mins < 0 || mins > 59 || str[5] != ':') return -1;
+	secs = parse_digits(str + 6);
+	if (secs < 0 || secs > 59) return -1;
+
+	switch (str[8]) {
+		case ':':
+			drop_frame = 0;
+			break;
+		case ';':
+		case '.':
+			drop_frame = 1;
+			break;
+		default:
+			return -1;
+	}
+
+	/* frame tens are 2 bits in the LTC frame */
+	frame = parse_digits(str + 9);
+	if (frame < 0 || frame > 39 || (unsigned char)(str[11] - '0') < 10) return -1;
+	/* labels skipped by drop-frame timecode */
+	if (drop_frame && frame < DROP_FRAMES && secs == 0 && mins % 10 != 0) return -1;
+
+	stime->hours = hours;
+	stime->mins  = mins;
+	stime->secs  = secs;
+	stime->frame = frame;
+	return drop_frame;
+}
+
 int ltc_frame_parse_bcg_flags(LTCFrame *frame, enum LTC_TV_STANDARD standard) {
 	switch (standard) {
 		case LTC_TV_625_50: /* 25 fps mode */
@@ -0,0 +1,180 @@
+/**
+   @brief self-test for the libltc decoder bank
+   @file ltcbank.c
+
+   Copyright (C) 2026 The libltc contributors
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU Lesser Public License as published by
+   the Free Software Foundation; either version 3, or (at your option)
+   any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with this library; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+*/
+
+/* An interleaved buffer of N_CHANNELS different LTC signals (frame-rate,
+ * start time, level, filter, noise, direction and phase) is decoded with an
+ * LTCDecoderBank and, channel by channel, with one LTCDecoder each.
+ * Both must deliver the same frames. The channel count is not a multiple
+ * of the SIMD width, and the buffer is written in blocks of random size.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <ltc.h>
+
+#define N_CHANNELS 21
+#define N_FRAMES 20
+#define SAMPLE_RATE 48000
+
+/* encode one channel, return the number of samples */
+static size_t encode_channel(int c, ltcsnd_sample_t *out, size_t len) {
+	const double fps = c % 2 ? 25 : 30;
+	const int reverse = c % 3 == 2;
+	LTCEncoder *encoder = ltc_encoder_create(SAMPLE_RATE, fps, fps == 25 ? LTC_TV_625_50 : LTC_TV_525_60, 0);
+	SMPTETimecode st;
+	const size_t start = 37 * c; /* phase offset, silence */
+	size_t n = start;
+	int f;
+
+	memset(out, 128, len);
+	memset(&st, 0, sizeof(st));
+	strcpy(st.timezone, "+0000");
+	st.hours = c;
+	st.mins = 59;
+	st.secs = 59;
+	ltc_encoder_set_timecode(encoder, &st);
+	ltc_encoder_set_volume(encoder, -1.0 - c);
+	if (c % 4 == 3) {
+		ltc_encoder_set_filter(encoder, 0);
+	} else if (c % 4 == 1) {
+		/* slow edges, the detection threshold matters */
+		ltc_encoder_set_filter(encoder, 500);
+	}
+
+	for (f = 0; f < N_FRAMES; ++f) {
+		ltcsnd_sample_t *buf;
+		int cnt;
+		if (reverse) {
+			ltc_encoder_encode_reversed_frame(encoder);
+			ltc_encoder_dec_timecode(encoder);
+		} else {
+			ltc_encoder_encode_frame(encoder);
+			ltc_encoder_inc_timecode(encoder);
+		}
+		cnt = ltc_encoder_get_bufferptr(encoder, &buf, 1);
+		if (n + cnt > len) {
+			break;
+		}
+		memcpy(&out[n], buf, cnt);
+		n += cnt;
+	}
+
+	if (c % 5 == 4) {
+		/* noise on the signal */
+		unsigned int seed = c;
+		size_t i;
+		for (i = start; i < n; ++i) {
+			seed = seed * 1103515245 + 12345;
+			out[i] += (int)((seed >> 16) % 9) - 4;
+		}
+	}
+	ltc_encoder_free(encoder);
+	return n;
+}
+
+static int frames_equal(const LTCFrameExt *a, const LTCFrameExt *b) {
+	return !memcmp(&a->ltc, &b->ltc, sizeof(LTCFrame))
+		&& a->off_start == b->off_start
+		&& a->off_end == b->off_end
+		&& a->reverse == b->reverse
+		&& !memcmp(a->biphase_tics, b->biphase_tics, sizeof(a->biphase_tics))
+		&& a->sample_min == b->sample_min
+		&& a->sample_max == b->sample_max
+		&& a->volume == b->volume;
+}
+
+int main(int argc, char **argv) {
+	const size_t len = (N_FRAMES + 2) * (SAMPLE_RATE / 25);
+	const int apv = SAMPLE_RATE / 25;
+	ltcsnd_sample_t *mono = (ltcsnd_sample_t*) malloc(N_CHANNELS * len);
+	ltcsnd_sample_t *interleaved = (ltcsnd_sample_t*) malloc(N_CHANNELS * len);
+	LTCDecoderBank *bank = ltc_decoder_bank_create(N_CHANNELS, apv, N_FRAMES);
+	LTCDecoder *decoder[N_CHANNELS];
+	unsigned int seed = 1;
+	size_t off, i;
+	int failed = 0;
+	int c;
+
+	if (!mono || !interleaved || !bank) {
+		fprintf(stderr, "Error: out of memory\n");
+		return 1;
+	}
+
+	for (c = 0; c < N_CHANNELS; ++c) {
+		encode_channel(c, &mono[c * len], len);
+		for (i = 0; i < len; ++i) {
+			interleaved[i * N_CHANNELS + c] = mono[c * len + i];
+		}
+		decoder[c] = ltc_decoder_create(apv, N_FRAMES);
+	}
+
+	for (off = 0; off < len; ) {
+		size_t n;
+		seed = seed * 1103515245 + 12345;
+		n = 1 + (seed >> 16) % 1500;
+		if (n > len - off) {
+			n = len - off;
+		}
+		ltc_decoder_bank_write(bank, &interleaved[off * N_CHANNELS], n, off);
+		for (c = 0; c < N_CHANNELS; ++c) {
+			ltc_decoder_write(decoder[c], &mono[c * len + off], n, off);
+		}
+		off += n;
+	}
+
+	for (c = 0; c < N_CHANNELS; ++c) {
+		LTCFrameExt a, b;
+		int n_frames = 0;
+
+		if (ltc_decoder_bank_queue_length(bank, c) != ltc_decoder_queue_length(decoder[c])) {
+			fprintf(stderr, "Error: channel %d, bank decoded %d frames, decoder %d\n", c,
+					ltc_decoder_bank_queue_length(bank, c), ltc_decoder_queue_length(decoder[c]));
+			++failed;
+		}
+		while (ltc_decoder_read(decoder[c], &a)) {
+			if (ltc_decoder_bank_read(bank, c, &b) != 1 || !frames_equal(&a, &b)) {
+				fprintf(stderr, "Error: channel %d, frame %d differs\n", c, n_frames);
+				++failed;
+				break;
+			}
+			++n_frames;
+		}
+		/* the first frame may be lost while the decoder adapts */
+		if (n_frames < N_FRAMES - 2) {
+			fprintf(stderr, "Error: channel %d, only %d frames decoded\n", c, n_frames);
+			++failed;
+		}
+		ltc_decoder_free(decoder[c]);
+	}
+
+	ltc_decoder_bank_free(bank);
+	free(mono);
+	free(interleaved);
+
+	if (failed) {
+		fprintf(stderr, "%d decoder bank tests failed.\n", failed);
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,416 @@
+/**
+   @brief benchmark libltc LTCDecoder
+   @file ltcbench.c
+
+   Copyright (C) 2026 The libltc contributors
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU Lesser Public License as published by
+   the Free Software Foundation; either version 3, or (at your option)
+   any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with this library; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+*/
+
+/* Every ltc_decoder_write* variant is timed for all combinations of
+ * sample-rate, signal (forward, reverse, varispeed), clean or noisy input
+ * and block size. One CSV line is written to stdout per measurement:
+ *
+ *   variant,sample_rate,signal,noise,block_size,channels,samples,ns_per_sample,msamples_per_sec,frames
+ *
+ * `samples` is the total number of (per channel) samples that were decoded,
+ * `frames` the number of LTC frames decoded per pass over the signal and
+ * channel; it is expected to be close to N_FRAMES.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+#include <ltc.h>
+
+/* default minimum CPU time to spend on each measurement */
+#define MIN_BENCH_TIME 0.05
+
+/* length of the test signal in LTC frames */
+#define N_FRAMES 100
+
+/* default channel counts of the strided, interleaved and bank variants.
+ * The decoder bank processes 16 channels per SIMD step. */
+static const int channel_counts[] = { 16, 64, 256 };
+
+enum bench_format { FMT_U8, FMT_DOUBLE, FMT_FLOAT, FMT_S16, FMT_U16 };
+enum bench_layout { LAYOUT_MONO, LAYOUT_STRIDED, LAYOUT_INTERLEAVED, LAYOUT_BANK };
+
+struct bench_ctx {
+	int n_channels; ///< channels in buf
+	LTCDecoder **d;
+	LTCDecoderBank *bank;
+	void *buf;
+};
+
+typedef void (*bench_write_fn)(struct bench_ctx *c, size_t off, size_t n, ltc_off_t posinfo);
+
+struct bench_variant {
+	const char *name;
+	enum bench_format format;
+	enum bench_layout layout;
+	bench_write_fn write;
+};
+
+#define BENCH_MONO_TEMPLATE(NAME, FORMAT, FN) \
+static void NAME(struct bench_ctx *c, size_t off, size_t n, ltc_off_t posinfo) { \
+	FN(c->d[0], &((FORMAT*)c->buf)[off], n, posinfo); \
+}
+
+#define BENCH_STRIDED_TEMPLATE(NAME, FORMAT, FN) \
+static void NAME(struct bench_ctx *c, size_t off, size_t n, ltc_off_t posinfo) { \
+	FN(c->d[0], &((FORMAT*)c->buf)[off * c->n_channels], n, c->n_channels, posinfo); \
+}
+
+#define BENCH_INTERLEAVED_TEMPLATE(NAME, FORMAT, FN) \
+static void NAME(struct bench_ctx *c, size_t off, size_t n, ltc_off_t posinfo) { \
+	FN(c->d, c->n_channels, &((FORMAT*)c->buf)[off * c->n_channels], n, posinfo); \
+}
+
+BENCH_MONO_TEMPLATE(bench_u8, ltcsnd_sample_t, ltc_decoder_write)
+BENCH_MONO_TEMPLATE(bench_double, double, ltc_decoder_write_double)
+BENCH_MONO_TEMPLATE(bench_float, float, ltc_decoder_write_float)
+BENCH_MONO_TEMPLATE(bench_s16, short, ltc_decoder_write_s16)
+BENCH_MONO_TEMPLATE(bench_u16, unsigned short, ltc_decoder_write_u16)
+
+BENCH_STRIDED_TEMPLATE(bench_u8_strided, ltcsnd_sample_t, ltc_decoder_write_strided)
+BENCH_STRIDED_TEMPLATE(bench_double_strided, double, ltc_decoder_write_double_strided)
+BENCH_STRIDED_TEMPLATE(bench_float_strided, float, ltc_decoder_write_float_strided)
+BENCH_STRIDED_TEMPLATE(bench_s16_strided, short, ltc_decoder_write_s16_strided)
+BENCH_STRIDED_TEMPLATE(bench_u16_strided, unsigned short, ltc_decoder_write_u16_strided)
+
+BENCH_INTERLEAVED_TEMPLATE(bench_u8_interleaved, ltcsnd_sample_t, ltc_decoder_write_interleaved)
+BENCH_INTERLEAVED_TEMPLATE(bench_double_interleaved, double, ltc_decoder_write_double_interleaved)
+BENCH_INTERLEAVED_TEMPLATE(bench_float_interleaved, float, ltc_decoder_write_float_interleaved)
+BENCH_INTERLEAVED_TEMPLATE(bench_s16_interleaved, short, ltc_decoder_write_s16_interleaved)
+BENCH_INTERLEAVED_TEMPLATE(bench_u16_interleaved, unsigned short, ltc_decoder_write_u16_interleaved)
+
+static void bench_bank(struct bench_ctx *c, size_t off, size_t n, ltc_off_t posinfo) {
+	ltc_decoder_bank_write(c->bank, &((ltcsnd_sample_t*)c->buf)[off * c->n_channels], n, posinfo);
+}
+
+static const struct bench_variant variants[] = {
+	{ "write",                    FMT_U8,     LAYOUT_MONO,        bench_u8 },
+	{ "write_double",             FMT_DOUBLE, LAYOUT_MONO,        bench_double },
+	{ "write_float",              FMT_FLOAT,  LAYOUT_MONO,        bench_float },
+	{ "write_s16",                FMT_S16,    LAYOUT_MONO,        bench_s16 },
+	{ "write_u16",                FMT_U16,    LAYOUT_MONO,        bench_u16 },
+	{ "write_strided",            FMT_U8,     LAYOUT_STRIDED,     bench_u8_strided },
+	{ "write_double_strided",     FMT_DOUBLE, LAYOUT_STRIDED,     bench_double_strided },
+	{ "write_float_strided",      FMT_FLOAT,  LAYOUT_STRIDED,     bench_float_strided },
+	{ "write_s16_strided",        FMT_S16,    LAYOUT_STRIDED,     bench_s16_strided },
+	{ "write_u16_strided",        FMT_U16,    LAYOUT_STRIDED,     bench_u16_strided },
+	{ "write_interleaved",        FMT_U8,     LAYOUT_INTERLEAVED, bench_u8_interleaved },
+	{ "write_double_interleaved", FMT_DOUBLE, LAYOUT_INTERLEAVED, bench_double_interleaved },
+	{ "write_float_interleaved",  FMT_FLOAT,  LAYOUT_INTERLEAVED, bench_float_interleaved },
+	{ "write_s16_interleaved",    FMT_S16,    LAYOUT_INTERLEAVED, bench_s16_interleaved },
+	{ "write_u16_interleaved",    FMT_U16,    LAYOUT_INTERLEAVED, bench_u16_interleaved },
+	{ "bank_write",               FMT_U8,     LAYOUT_BANK,        bench_bank },
+};
+
+static const double sample_rates[] = { 44100, 48000, 96000, 192000 };
+static const char *signal_names[] = { "forward", "reverse", "varispeed" };
+static const size_t block_sizes[] = { 1, 64, 1024, 16384 };
+
+/**
+ * encode N_FRAMES of LTC at 25 fps, either forward or played in reverse
+ * @return normalized signal -1..+1
+ */
+static float* encode_ltc(double sample_rate, int reverse, size_t *len) {
+	const double fps = 25;
+	LTCEncoder *encoder = ltc_encoder_create(sample_rate, fps, LTC_TV_625_50, 0);
+	size_t frame_size = ltc_encoder_get_buffersize(encoder);
+	ltcsnd_sample_t *buf = malloc(N_FRAMES * frame_size);
+	float *sig;
+	SMPTETimecode st;
+	size_t i;
+	int f;
+
+	memset(&st, 0, sizeof(st));
+	strcpy(st.timezone, "+0000");
+	st.hours = 10;
+	ltc_encoder_set_timecode(encoder, &st);
+
+	*len = 0;
+	for (f = 0; f < N_FRAMES; ++f) {
+		if (reverse) {
+			ltc_encoder_encode_reversed_frame(encoder);
+			ltc_encoder_dec_timecode(encoder);
+		} else {
+			ltc_encoder_encode_frame(encoder);
+			ltc_encoder_inc_timecode(encoder);
+		}
+		*len += ltc_encoder_copy_buffer(encoder, &buf[*len]);
+	}
+	ltc_encoder_free(encoder);
+
+	sig = malloc(*len * sizeof(float));
+	for (i = 0; i < *len; ++i) {
+		sig[i] = (buf[i] - 128) / 127.f;
+	}
+	free(buf);
+	return sig;
+}
+
+/**
+ * resample the signal with a speed that varies sinusoidally between 0.8 and 1.2
+ */
+static float* varispeed(const float *src, size_t src_len, double sample_rate, size_t *len) {
+	float *sig = malloc(2 * src_len * sizeof(float));
+	double pos = 0;
+	size_t n = 0;
+
+	while (pos < src_len - 1) {
+		const size_t p = (size_t) pos;
+		const float frac = pos - p;
+		sig[n] = src[p] + frac * (src[p + 1] - src[p]);
+		pos += 1.0 + 0.2 * sin(2.0 * M_PI * n / sample_rate);
+		++n;
+	}
+	*len = n;
+	return sig;
+}
+
+/**
+ * reduce the level and add reproducible white noise
+ */
+static void add_noise(float *sig, size_t len) {
+	unsigned int seed = 1;
+	size_t i;
+	for (i = 0; i < len; ++i) {
+		seed = seed * 1103515245 + 12345;
+		sig[i] = .5f * sig[i] + .2f * (((seed >> 8) & 0xffff) / 32768.f - 1.f);
+	}
+}
+
+/**
+ * convert the signal into the given format. Multi-channel layouts
+ * interleave n_channels copies of the signal, each starting at a different
+ * position.
+ */
+static void* make_buffer(const float *sig, size_t len, enum bench_format format, int n_channels) {
+	static const size_t sample_size[] = {
+		sizeof(ltcsnd_sample_t), sizeof(double), sizeof(float), sizeof(short), sizeof(unsigned short)
+	};
+	void *buf = malloc(len * n_channels * sample_size[format]);
+	size_t i;
+	int c;
+
+	for (i = 0; i < len; ++i) {
+		for (c = 0; c < n_channels; ++c) {
+			const float v = sig[(i + c * 997) % len];
+			const size_t k = i * n_channels + c;
+			switch (format) {
+				case FMT_U8:
+					((ltcsnd_sample_t*)buf)[k] = 128 + v * 127;
+					break;
+				case FMT_DOUBLE:
+					((double*)buf)[k] = v;
+					break;
+				case FMT_FLOAT:
+					((float*)buf)[k] = v;
+					break;
+				case FMT_S16:
+					((short*)buf)[k] = v * 32767;
+					break;
+				case FMT_U16:
+					((unsigned short*)buf)[k] = 32768 + v * 32767;
+					break;
+			}
+		}
+	}
+	return buf;
+}
+
+/**
+ * decode the signal repeatedly in blocks of block_size using the given variant
+ * @return nanoseconds per (per channel) sample
+ */
+static double bench_decode(const struct bench_variant *v, void *buf, int n_buf_channels, size_t len, int apv, size_t block_size, double min_time, int *n_channels, long long *n_samples, double *n_decoded) {
+	struct bench_ctx ctx;
+	LTCFrameExt frame;
+	ltc_off_t total = 0;
+	long long frames = 0;
+	int passes = 0;
+	clock_t start;
+	double elapsed;
+	int c;
+
+	memset(&ctx, 0, sizeof(ctx));
+	ctx.buf = buf;
+	ctx.n_channels = n_buf_channels;
+	ctx.d = calloc(n_buf_channels, sizeof(LTCDecoder*));
+
+	*n_channels = (v->layout == LAYOUT_INTERLEAVED || v->layout == LAYOUT_BANK) ? n_buf_channels : 1;
+
+	if (v->layout == LAYOUT_BANK) {
+		ctx.bank = ltc_decoder_bank_create(n_buf_channels, apv, 32);
+	} else {
+		for (c = 0; c < *n_channels; ++c) {
+			ctx.d[c] = ltc_decoder_create(apv, 32);
+		}
+	}
+
+	start = clock();
+	do {
+		size_t off;
+		for (off = 0; off < len; off += block_size) {
+			size_t n = (len - off > block_size) ? block_size : len - off;
+			v->write(&ctx, off, n, total);
+			total += n;
+			for (c = 0; c < *n_channels; ++c) {
+				if (ctx.bank) {
+					while (ltc_decoder_bank_read(ctx.bank, c, &frame) > 0) {
+						++frames;
+					}
+				} else {
+					while (ltc_decoder_read(ctx.d[c], &frame)) {
+						++frames;
+					}
+				}
+			}
+		}
+		++passes;
+		elapsed = (clock() - start) / (double) CLOCKS_PER_SEC;
+	} while (elapsed < min_time);
+
+	if (ctx.bank) {
+		ltc_decoder_bank_free(ctx.bank);
+	}
+	for (c = 0; c < n_buf_channels; ++c) {
+		ltc_decoder_free(ctx.d[c]);
+	}
+	free(ctx.d);
+
+	*n_samples = total * *n_channels;
+	*n_decoded = frames / (double)(passes * *n_channels);
+	return 1e9 * elapsed / *n_samples;
+}
+
+static void usage(const char *argv0) {
+	printf("Usage: %s [-t seconds] [-r sample-rate] [-b block-size] [-c channels] [-v variant]\n\n", argv0);
+	printf("Benchmark all ltc_decoder_write* variants and print the results as CSV.\n\n");
+	printf("  -t seconds      minimum CPU time per measurement (default %g)\n", MIN_BENCH_TIME);
+	printf("  -r sample-rate  only run the given sample-rate\n");
+	printf("  -b block-size   only run the given block-size\n");
+	printf("  -c channels     channel count of the multi-channel variants (default 16, 64 and 256)\n");
+	printf("  -v variant      only run the given variant, e.g. \"write_float\"\n");
+}
+
+int main(int argc, char **argv) {
+	double min_time = MIN_BENCH_TIME;
+	double only_rate = 0;
+	size_t only_block = 0;
+	int only_channels = 0;
+	const char *only_variant = NULL;
+	unsigned int r, s, b, v, ch;
+	int noise;
+	int i;
+
+	for (i = 1; i < argc; ++i) {
+		if (!strcmp(argv[i], "-t") && i + 1 < argc) {
+			min_time = atof(argv[++i]);
+		} else if (!strcmp(argv[i], "-r") && i + 1 < argc) {
+			only_rate = atof(argv[++i]);
+		} else if (!strcmp(argv[i], "-b") && i + 1 < argc) {
+			only_block = atol(argv[++i]);
+		} else if (!strcmp(argv[i], "-c") && i + 1 < argc) {
+			only_channels = atoi(argv[++i]);
+			if (only_channels < 1) {
+				usage(argv[0]);
+				return -1;
+			}
+		} else if (!strcmp(argv[i], "-v") && i + 1 < argc) {
+			only_variant = argv[++i];
+		} else {
+			usage(argv[0]);
+			return !strcmp(argv[i], "-h") ? 0 : -1;
+		}
+	}
+
+	printf("# libltc-%s decoder benchmark\n", LIBLTC_VERSION);
+	printf("variant,sample_rate,signal,noise,block_size,channels,samples,ns_per_sample,msamples_per_sec,frames\n");
+
+	for (r = 0; r < sizeof(sample_rates) / sizeof(sample_rates[0]); ++r) {
+		const double sample_rate = sample_rates[r];
+		const int apv = sample_rate / 25;
+		float *fwd, *rev, *vari;
+		size_t fwd_len, rev_len, vari_len;
+
+		if (only_rate > 0 && only_rate != sample_rate) {
+			continue;
+		}
+
+		fwd = encode_ltc(sample_rate, 0, &fwd_len);
+		rev = encode_ltc(sample_rate, 1, &rev_len);
+		vari = varispeed(fwd, fwd_len, sample_rate, &vari_len);
+
+		for (s = 0; s < 3; ++s) {
+			for (noise = 0; noise < 2; ++noise) {
+				float *sig = s == 0 ? fwd : s == 1 ? rev : vari;
+				size_t len = s == 0 ? fwd_len : s == 1 ? rev_len : vari_len;
+				float *noisy = NULL;
+
+				if (noise) {
+					noisy = malloc(len * sizeof(float));
+					memcpy(noisy, sig, len * sizeof(float));
+					add_noise(noisy, len);
+					sig = noisy;
+				}
+
+				for (v = 0; v < sizeof(variants) / sizeof(variants[0]); ++v) {
+					const struct bench_variant *bv = &variants[v];
+					const unsigned int n_counts = bv->layout == LAYOUT_MONO || only_channels ? 1 : sizeof(channel_counts) / sizeof(channel_counts[0]);
+
+					if (only_variant && strcmp(only_variant, bv->name)) {
+						continue;
+					}
+
+					for (ch = 0; ch < n_counts; ++ch) {
+						const int n_buf_channels = bv->layout == LAYOUT_MONO ? 1 : only_channels ? only_channels : channel_counts[ch];
+						void *buf = make_buffer(sig, len, bv->format, n_buf_channels);
+
+						for (b = 0; b < sizeof(block_sizes) / sizeof(block_sizes[0]); ++b) {
+							const size_t block_size = block_sizes[b];
+							int n_channels;
+							long long n_samples;
+							double n_decoded, ns;
+
+							if (only_block > 0 && only_block != block_size) {
+								continue;
+							}
+
+							ns = bench_decode(bv, buf, n_buf_channels, len, apv, block_size, min_time, &n_channels, &n_samples, &n_decoded);
+							printf("%s,%.0f,%s,%s,%zu,%d,%lld,%.3f,%.3f,%.1f\n",
+									bv->name, sample_rate, signal_names[s], noise ? "noisy" : "clean",
+									block_size, n_channels, n_samples, ns, 1e3 / ns, n_decoded);
+							fflush(stdout);
+						}
+						free(buf);
+					}
+				}
+				free(noisy);
+			}
+		}
+		free(fwd);
+		free(rev);
+		free(vari);
+	}
+	return 0;
+}
@@ -0,0 +1,182 @@
+/**
+   @brief benchmark libltc LTCEncoder
+   @file ltcencbench.c
+
+   Copyright (C) 2026 The libltc contributors
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU Lesser Public License as published by
+   the Free Software Foundation; either version 3, or (at your option)
+   any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with this library; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+*/
+
+/* The encoder is timed for all combinations of sample-rate, filter
+ * (default 40us rise-time low-pass or perfect square wave), direction and
+ * speed, for each output sample format. Speed 1 is encoded with ltc_encoder_encode_frame() or
+ * ltc_encoder_encode_reversed_frame() ("frame"), other speeds byte by byte
+ * with ltc_encoder_encode_byte() ("byte"). Full frames are also timed with
+ * the waveform cache enabled ("cached"). The timecode is advanced after
+ * every frame and the buffer flushed without copying it.
+ *
+ * One CSV line is written to stdout per measurement:
+ *
+ *   api,format,sample_rate,fps,filter,direction,speed,samples,ns_per_sample,msamples_per_sec,realtime
+ *
+ * `realtime` is the number of outputs that one CPU core can generate
+ * in realtime.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <ltc.h>
+
+/* default minimum CPU time to spend on each measurement */
+#define MIN_BENCH_TIME 0.05
+
+/* slowest speed, the internal buffer is sized to hold one frame at this speed */
+#define MIN_SPEED 0.5
+
+static const double sample_rates[] = { 48000, 96000, 192000, 384000 };
+static const double speeds[] = { 1.0, MIN_SPEED, 0.97, 1.0, 1.5, 2.0 };
+static const enum LTC_SAMPLE_FORMAT formats[] = { LTC_SAMPLE_U8, LTC_SAMPLE_S16, LTC_SAMPLE_S32, LTC_SAMPLE_FLOAT };
+static const char *format_names[] = { "u8", "s16", "s32", "float" };
+
+/**
+ * encode frames repeatedly
+ * @param use_byte use ltc_encoder_encode_byte() instead of encoding full frames
+ * @param cache enable the waveform cache
+ * @return nanoseconds per sample, -1 if encoding failed
+ */
+static double bench_encode(double sample_rate, double fps, enum LTC_SAMPLE_FORMAT format, int filter, int reverse, int use_byte, int cache, double speed, double min_time, long long *n_samples) {
+	LTCEncoder *encoder = ltc_encoder_create(sample_rate, fps, LTC_TV_625_50, 0);
+	SMPTETimecode st;
+	clock_t start;
+	double elapsed;
+	int err = 0;
+	int n;
+
+	ltc_encoder_set_buffersize(encoder, sample_rate, fps * MIN_SPEED);
+	ltc_encoder_set_sample_format(encoder, format);
+	ltc_encoder_set_waveform_cache(encoder, cache);
+	if (!filter) {
+		ltc_encoder_set_filter(encoder, 0);
+	}
+
+	memset(&st, 0, sizeof(st));
+	strcpy(st.timezone, "+0000");
+	st.hours = 10;
+	ltc_encoder_set_timecode(encoder, &st);
+
+	*n_samples = 0;
+	start = clock();
+	do {
+		/* check the time only every 25 frames */
+		for (n = 0; n < 25; ++n) {
+			int byte;
+			if (!use_byte) {
+				if (reverse) {
+					ltc_encoder_encode_reversed_frame(encoder);
+				} else {
+					ltc_encoder_encode_frame(encoder);
+				}
+			} else if (reverse) {
+				for (byte = 9 ; byte >= 0 ; --byte) {
+					err |= ltc_encoder_encode_byte(encoder, byte, -speed);
+				}
+			} else {
+				for (byte = 0 ; byte < 10 ; byte++) {
+					err |= ltc_encoder_encode_byte(encoder, byte, speed);
+				}
+			}
+			if (reverse) {
+				ltc_encoder_dec_timecode(encoder);
+			} else {
+				ltc_encoder_inc_timecode(encoder);
+			}
+			*n_samples += ltc_encoder_get_bufferptr(encoder, NULL, 1);
+		}
+		elapsed = (clock() - start) / (double) CLOCKS_PER_SEC;
+	} while (elapsed < min_time && !err);
+
+	ltc_encoder_free(encoder);
+	return err ? -1 : 1e9 * elapsed / *n_samples;
+}
+
+static void usage(const char *argv0) {
+	printf("Usage: %s [-t seconds] [-r sample-rate]\n\n", argv0);
+	printf("Benchmark the LTC encoder and print the results as CSV.\n\n");
+	printf("  -t seconds      minimum CPU time per measurement (default %g)\n", MIN_BENCH_TIME);
+	printf("  -r sample-rate  only run the given sample-rate\n");
+}
+
+int main(int argc, char **argv) {
+	const double fps = 25;
+	double min_time = MIN_BENCH_TIME;
+	double only_rate = 0;
+	unsigned int r, f, s;
+	int filter, reverse;
+	int i;
+
+	for (i = 1; i < argc; ++i) {
+		if (!strcmp(argv[i], "-t") && i + 1 < argc) {
+			min_time = atof(argv[++i]);
+		} else if (!strcmp(argv[i], "-r") && i + 1 < argc) {
+			only_rate = atof(argv[++i]);
+		} else {
+			usage(argv[0]);
+			return !strcmp(argv[i], "-h") ? 0 : -1;
+		}
+	}
+
+	printf("# libltc-%s encoder benchmark\n", LIBLTC_VERSION);
+	printf("api,format,sample_rate,fps,filter,direction,speed,samples,ns_per_sample,msamples_per_sec,realtime\n");
+
+	for (r = 0; r < sizeof(sample_rates) / sizeof(sample_rates[0]); ++r) {
+		const double sample_rate = sample_rates[r];
+
+		if (only_rate > 0 && only_rate != sample_rate) {
+			continue;
+		}
+
+		for (f = 0; f < sizeof(formats) / sizeof(formats[0]); ++f) {
+			for (filter = 1; filter >= 0; --filter) {
+				for (reverse = 0; reverse < 2; ++reverse) {
+					for (s = 0; s < sizeof(speeds) / sizeof(speeds[0]); ++s) {
+						/* the first entry uses the full frame API, without and with cache */
+						const int use_byte = s > 0;
+						int cache;
+						for (cache = 0; cache <= !use_byte; ++cache) {
+							long long n_samples;
+							double ns;
+
+							ns = bench_encode(sample_rate, fps, formats[f], filter, reverse, use_byte, cache, speeds[s], min_time, &n_samples);
+							if (ns < 0) {
+								fprintf(stderr, "Error: encoding failed, %s %.0f speed %g\n", format_names[f], sample_rate, speeds[s]);
+								return 1;
+							}
+							printf("%s,%s,%.0f,%g,%s,%s,%g,%lld,%.3f,%.3f,%.1f\n",
+									use_byte ? "byte" : cache ? "cached" : "frame", format_names[f], sample_rate, fps,
+									filter ? "filtered" : "square", reverse ? "reverse" : "forward",
+									speeds[s], n_samples, ns, 1e3 / ns, 1e9 / ns / sample_rate);
+							fflush(stdout);
+						}
+					}
+				}
+			}
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,131 @@
+/**
+   @brief self-test for the libltc encoder waveform cache
+   @file ltcencoder.c
+
+   Copyright (C) 2026 The libltc contributors
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU Lesser Public License as published by
+   the Free Software Foundation; either version 3, or (at your option)
+   any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with this library; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+*/
+
+/* An encoder with the waveform cache enabled must produce the same
+ * samples as one without, also when the sample format, volume or
+ * sample-rate is changed while the cache holds data.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <ltc.h>
+
+#define N_FRAMES 12
+
+static int failed = 0;
+
+static size_t sample_size(enum LTC_SAMPLE_FORMAT format) {
+	switch (format) {
+		case LTC_SAMPLE_FLOAT: return sizeof(float);
+		case LTC_SAMPLE_S16:   return sizeof(short);
+		case LTC_SAMPLE_S32:   return sizeof(int);
+		default:               return sizeof(ltcsnd_sample_t);
+	}
+}
+
+/* encode N_FRAMES frames, return the size in bytes */
+static int encode(LTCEncoder *e, const char *what, unsigned char **out) {
+	const size_t ss = sample_size(ltc_encoder_get_sample_format(e));
+	ltcsnd_sample_t *buf;
+	size_t size = 0;
+	int f;
+
+	for (f = 0; f < N_FRAMES; ++f) {
+		int len;
+		ltc_encoder_encode_frame(e);
+		len = ltc_encoder_get_bufferptr(e, &buf, 1);
+		if (len < 0 || (size_t) len > ltc_encoder_get_buffersize(e)) {
+			fprintf(stderr, "Error: %s, invalid length %d\n", what, len);
+			++failed;
+			return -1;
+		}
+		*out = (unsigned char*) realloc(*out, size + len * ss);
+		memcpy(*out + size, buf, len * ss);
+		size += len * ss;
+		ltc_encoder_inc_timecode(e);
+	}
+	return size;
+}
+
+static void compare(LTCEncoder *ref, LTCEncoder *cached, const char *what) {
+	unsigned char *a = NULL, *b = NULL;
+	const int na = encode(ref, what, &a);
+	const int nb = encode(cached, what, &b);
+
+	if (na != nb || (na > 0 && memcmp(a, b, na))) {
+		fprintf(stderr, "Error: %s, cached output differs\n", what);
+		++failed;
+	}
+	free(a);
+	free(b);
+}
+
+int main(int argc, char **argv) {
+	static const enum LTC_SAMPLE_FORMAT formats[] = {
+		LTC_SAMPLE_U8, LTC_SAMPLE_FLOAT, LTC_SAMPLE_S16, LTC_SAMPLE_S32, LTC_SAMPLE_U8
+	};
+	static const char *names[] = { "u8", "float", "s16", "s32", "u8" };
+	LTCEncoder *ref = ltc_encoder_create(48000, 25, LTC_TV_625_50, LTC_USE_DATE);
+	LTCEncoder *cached = ltc_encoder_create(48000, 25, LTC_TV_625_50, LTC_USE_DATE);
+	char what[64];
+	unsigned int i;
+
+	if (!ref || !cached || ltc_encoder_set_waveform_cache(cached, 1)) {
+		fprintf(stderr, "Error: cannot create encoder\n");
+		return 1;
+	}
+
+	for (i = 0; i < sizeof(formats) / sizeof(formats[0]); ++i) {
+		if (ltc_encoder_set_sample_format(ref, formats[i]) || ltc_encoder_set_sample_format(cached, formats[i])) {
+			fprintf(stderr, "Error: cannot set sample format %s\n", names[i]);
+			return 1;
+		}
+		snprintf(what, sizeof(what), "%s", names[i]);
+		compare(ref, cached, what);
+
+		ltc_encoder_set_volume(ref, -6.0 - i);
+		ltc_encoder_set_volume(cached, -6.0 - i);
+		snprintf(what, sizeof(what), "%s, volume %d dBFS", names[i], -6 - (int)i);
+		compare(ref, cached, what);
+	}
+
+	/* fewer samples per frame, then more */
+	ltc_encoder_reinit(ref, 44100, 25, LTC_TV_625_50, LTC_USE_DATE);
+	ltc_encoder_reinit(cached, 44100, 25, LTC_TV_625_50, LTC_USE_DATE);
+	compare(ref, cached, "u8, 44.1kHz");
+	ltc_encoder_reinit(ref, 48000, 25, LTC_TV_625_50, LTC_USE_DATE);
+	ltc_encoder_reinit(cached, 48000, 25, LTC_TV_625_50, LTC_USE_DATE);
+	ltc_encoder_set_sample_format(ref, LTC_SAMPLE_FLOAT);
+	ltc_encoder_set_sample_format(cached, LTC_SAMPLE_FLOAT);
+	compare(ref, cached, "float, 48kHz");
+
+	ltc_encoder_free(ref);
+	ltc_encoder_free(cached);
+
+	if (failed) {
+		fprintf(stderr, "%d encoder tests failed.\n", failed);
+		return 1;
+	}
+	return 0;
+}
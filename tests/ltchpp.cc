@@ -0,0 +1,96 @@
+/**
+   @brief self-test for the C++ header ltc.hpp
+   @file ltchpp.cc
+
+   Copyright (C) 2026 The libltc contributors
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU Lesser Public License as published by
+   the Free Software Foundation; either version 3, or (at your option)
+   any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with this library; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+*/
+
+/* ltc::Timecode is stepped through a whole day next to an LTCFrame that
+ * is advanced with ltc_frame_increment(). to_frame(), pack(), from_frame()
+ * and index() must agree with the C functions for every frame.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include <ltc.hpp>
+
+/* the example of the documentation, evaluated at compile time */
+typedef ltc::Timecode<LTC_TV_525_60, true> TC2997;
+constexpr TC2997 start (1, 0, 0, 0);
+static_assert ((start + 1800).mins () == 1 && (start + 1800).frame () == 2, "drop-frame");
+static_assert (TC2997 (0, 1, 0, 0) == TC2997 (0, 1, 0, 2), "dropped label");
+static_assert (TC2997 (23, 59, 59, 29) + 1 == TC2997 (), "wrap around");
+static_assert (TC2997::frames_per_day == 2589408, "frames per day");
+static_assert (ltc::Timecode<LTC_TV_625_50>::from_index (-1).frame () == 24, "negative index");
+
+constexpr LTCFrame const_frame = ltc::Timecode<LTC_TV_FILM_24> (10, 20, 30, 12).to_frame ();
+static_assert (const_frame.hours_tens == 1 && const_frame.mins_tens == 2 && const_frame.frame_units == 2, "to_frame");
+
+static int failed = 0;
+
+template <enum LTC_TV_STANDARD Standard, bool DropFrame>
+static void test_day () {
+	typedef ltc::Timecode<Standard, DropFrame> TC;
+	const int fps = TC::fps;
+	LTCFrame frame;
+	TC tc;
+	long long i;
+
+	ltc_frame_reset (&frame);
+	frame.dfbit = DropFrame;
+	ltc_frame_set_parity (&frame, Standard);
+
+	for (i = 0; i < TC::frames_per_day; ++i, ++tc) {
+		const LTCFrame f = tc.to_frame ();
+		LTCFrame packed;
+
+		/* pack() only modifies time, dfbit and parity */
+		memcpy (&packed, &frame, sizeof (LTCFrame));
+		packed.frame_units = packed.secs_tens = packed.hours_units = 0;
+		tc.pack (packed);
+
+		if (memcmp (&f, &frame, sizeof (LTCFrame)) || memcmp (&packed, &frame, sizeof (LTCFrame))
+				|| TC::from_frame (frame) != tc
+				|| tc.index () != i || ltc_frame_to_index (&frame, fps) != i) {
+			fprintf (stderr, "Error: %d%s fps, frame %lld differs\n", fps, DropFrame ? " drop-frame" : "", i);
+			++failed;
+			return;
+		}
+		ltc_frame_increment (&frame, fps, Standard, 0);
+	}
+
+	if (tc != TC () || TC () - 1 != TC::from_index (TC::frames_per_day - 1)) {
+		fprintf (stderr, "Error: %d%s fps, wrap around\n", fps, DropFrame ? " drop-frame" : "");
+		++failed;
+	}
+}
+
+int main (int argc, char **argv) {
+	test_day<LTC_TV_FILM_24, false> ();
+	test_day<LTC_TV_625_50, false> ();
+	test_day<LTC_TV_525_60, false> ();
+	test_day<LTC_TV_525_60, true> ();
+	test_day<LTC_TV_1125_60, false> ();
+
+	if (failed) {
+		fprintf (stderr, "%d C++ timecode tests failed.\n", failed);
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,240 @@
+/**
+   @brief multi-threaded offline LTC render, example and self-test
+   @file ltcrender.c
+
+   Copyright (C) 2026 The libltc contributors
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU Lesser Public License as published by
+   the Free Software Foundation; either version 3, or (at your option)
+   any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with this library; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+*/
+
+/* The timeline is split into one segment of consecutive frames per thread.
+ * Every thread uses its own encoder, skips to the first frame of its
+ * segment with ltc_encoder_skip_frames() and renders the segment with
+ * ltc_encoder_render_frames() directly into the shared output buffer.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#include <ltc.h>
+
+#ifdef _WIN32
+#include <fcntl.h> // for _fmode
+#endif
+
+#define MAX_THREADS 64
+
+struct render_job {
+	double sample_rate;
+	double fps;
+	SMPTETimecode start;
+	int first_frame;
+	int n_frames;
+	unsigned char *buf; ///< output for the complete timeline
+	size_t buf_len;
+	ltc_off_t off_start; ///< first sample of the segment
+	ltc_off_t off_end;
+};
+
+static LTCEncoder* create_encoder(struct render_job *job) {
+	LTCEncoder *encoder = ltc_encoder_create(job->sample_rate, job->fps,
+			job->fps == 25 ? LTC_TV_625_50 : LTC_TV_525_60, LTC_USE_DATE);
+	ltc_encoder_set_timecode(encoder, &job->start);
+	return encoder;
+}
+
+static void* render_segment(void *arg) {
+	struct render_job *job = (struct render_job*) arg;
+	LTCEncoder *encoder = create_encoder(job);
+
+	job->off_start = ltc_encoder_skip_frames(encoder, job->first_frame);
+	job->off_end = job->off_start + ltc_encoder_render_frames(encoder, job->n_frames,
+			&job->buf[job->off_start], job->buf_len - job->off_start);
+
+	ltc_encoder_free(encoder);
+	return NULL;
+}
+
+/**
+ * render n_frames using n_threads threads
+ * @return number of samples, -1 on error
+ */
+static ltc_off_t render(struct render_job *tmpl, int n_frames, int n_threads, unsigned char *buf, size_t buf_len) {
+	struct render_job jobs[MAX_THREADS];
+	pthread_t threads[MAX_THREADS];
+	int first_frame = 0;
+	int t;
+
+	for (t = 0; t < n_threads; ++t) {
+		memcpy(&jobs[t], tmpl, sizeof(struct render_job));
+		jobs[t].first_frame = first_frame;
+		jobs[t].n_frames = n_frames / n_threads + (t < n_frames % n_threads ? 1 : 0);
+		jobs[t].buf = buf;
+		jobs[t].buf_len = buf_len;
+		first_frame += jobs[t].n_frames;
+		if (jobs[t].n_frames == 0) {
+			jobs[t].off_start = jobs[t].off_end = 0;
+			continue;
+		}
+		if (pthread_create(&threads[t], NULL, render_segment, &jobs[t])) {
+			fprintf(stderr, "Error: can not start render thread.\n");
+			break;
+		}
+	}
+
+	if (t < n_threads) {
+		/* wait for the threads already started, they use jobs and buf */
+		while (--t >= 0) {
+			if (jobs[t].n_frames > 0) {
+				pthread_join(threads[t], NULL);
+			}
+		}
+		return -1;
+	}
+
+	for (t = 0; t < n_threads; ++t) {
+		if (jobs[t].n_frames > 0) {
+			pthread_join(threads[t], NULL);
+		}
+	}
+
+	/* segments are contiguous */
+	for (t = 1; t < n_threads; ++t) {
+		if (jobs[t].n_frames > 0 && jobs[t].off_start != jobs[t - 1].off_end) {
+			fprintf(stderr, "Error: segment %d does not continue segment %d.\n", t, t - 1);
+			return -1;
+		}
+	}
+	return n_frames > 0 ? jobs[(n_frames < n_threads ? n_frames : n_threads) - 1].off_end : 0;
+}
+
+static void usage(void) {
+	printf("ltcrender - render LTC to a file using multiple threads\n\n");
+	printf("Usage: ltcrender [-j threads] [-c] <filename> [sample rate [frame rate [duration in s]]]\n\n");
+	printf("  -c          also render single-threaded and compare (self-test)\n");
+	printf("  -j threads  number of threads to use (default 4)\n\n");
+	printf("default-values:\n");
+	printf(" sample rate: 48000.0 [SPS], frame rate: 25.0 [fps], duration: 60.0 [sec]\n");
+	printf("sample format: 8bit unsigned mono\n");
+}
+
+int main(int argc, char **argv) {
+	struct render_job tmpl;
+	double length = 60; // in seconds
+	int n_threads = 4;
+	int check = 0;
+	char *filename = NULL;
+	unsigned char *buf;
+	size_t buf_len;
+	ltc_off_t len;
+	int n_frames;
+	int i;
+
+	memset(&tmpl, 0, sizeof(tmpl));
+	tmpl.sample_rate = 48000;
+	tmpl.fps = 25;
+
+	strcpy(tmpl.start.timezone, "+0100");
+	tmpl.start.years =  8;
+	tmpl.start.months = 12;
+	tmpl.start.days =   31;
+	tmpl.start.hours = 23;
+	tmpl.start.mins = 59;
+	tmpl.start.secs = 59;
+	tmpl.start.frame = 0;
+
+	for (i = 1; i < argc; ++i) {
+		if (!strcmp(argv[i], "-j") && i + 1 < argc) {
+			n_threads = atoi(argv[++i]);
+		} else if (!strcmp(argv[i], "-c")) {
+			check = 1;
+		} else {
+			break;
+		}
+	}
+
+	if (i < argc) {
+		filename = argv[i++];
+		if (i < argc) {
+			tmpl.sample_rate = atof(argv[i++]);
+		}
+		if (i < argc) {
+			tmpl.fps = atof(argv[i++]);
+		}
+		if (i < argc) {
+			length = atof(argv[i++]);
+		}
+	} else {
+		usage();
+		return 1;
+	}
+
+	if (n_threads < 1 || n_threads > MAX_THREADS) {
+		fprintf(stderr, "Error: the number of threads must be 1..%d.\n", MAX_THREADS);
+		return 1;
+	}
+
+	n_frames = length * tmpl.fps;
+	buf_len = 2 + n_frames * tmpl.sample_rate / tmpl.fps;
+	buf = malloc(buf_len);
+	if (!buf) {
+		fprintf(stderr, "Error: out of memory.\n");
+		return 1;
+	}
+
+	len = render(&tmpl, n_frames, n_threads, buf, buf_len);
+	if (len < 0) {
+		free(buf);
+		return 1;
+	}
+
+	if (check) {
+		/* single-threaded reference */
+		unsigned char *ref = malloc(buf_len);
+		LTCEncoder *encoder = create_encoder(&tmpl);
+		ltc_off_t ref_len = ltc_encoder_render_frames(encoder, n_frames, ref, buf_len);
+		ltc_encoder_free(encoder);
+
+		if (ref_len != len || memcmp(ref, buf, len)) {
+			fprintf(stderr, "Error: multi-threaded render differs from single-threaded render.\n");
+			free(ref);
+			free(buf);
+			return 1;
+		}
+		free(ref);
+	}
+
+#ifdef _WIN32
+	_set_fmode(_O_BINARY);
+#endif
+
+	FILE *file = fopen(filename, "wb");
+	if (!file) {
+		fprintf(stderr, "Error: can not open file '%s' for writing.\n", filename);
+		free(buf);
+		return 1;
+	}
+	if (fwrite(buf, sizeof(ltcsnd_sample_t), len, file) != (size_t) len) {
+		fprintf(stderr, "Error: writing to file '%s' failed.\n", filename);
+	}
+	fclose(file);
+	free(buf);
+
+	printf("Done: wrote %lld samples (%d frames, %d threads) to '%s'\n", len, n_frames, n_threads, filename);
+	return 0;
+}
@@ -0,0 +1,321 @@
+/**
+   @brief self-test for libltc timecode arithmetic
+   @file ltctimecode.c
+
+   Copyright (C) 2026 The libltc contributors
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU Lesser Public License as published by
+   the Free Software Foundation; either version 3, or (at your option)
+   any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with this library; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+*/
+
+/* ltc_frame_add(), ltc_frame_difference() and the frame index conversions
+ * are compared against stepping with ltc_frame_increment() and
+ * ltc_frame_decrement(). Timezone codes and timecode strings are checked
+ * to survive the conversion to SMPTETimecode and back, and the batch
+ * conversions to match the per-frame functions.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <ltc.h>
+
+struct rate {
+	int fps;
+	int drop_frame;
+	enum LTC_TV_STANDARD standard;
+};
+
+static const struct rate rates[] = {
+	{ 24, 0, LTC_TV_FILM_24 },
+	{ 25, 0, LTC_TV_625_50 },
+	{ 30, 0, LTC_TV_525_60 },
+	{ 30, 1, LTC_TV_525_60 },
+};
+
+static int failed = 0;
+
+static void check(int ok, const char *what, const struct rate *r, long long n) {
+	if (!ok) {
+		fprintf(stderr, "Error: %s, %d%s fps, n=%lld\n", what, r->fps, r->drop_frame ? " drop-frame" : "", n);
+		++failed;
+	}
+}
+
+static void init_frame(LTCFrame *frame, const struct rate *r, SMPTETimecode *st) {
+	ltc_frame_reset(frame);
+	frame->dfbit = r->drop_frame;
+	ltc_time_to_frame(frame, st, r->standard, LTC_USE_DATE);
+}
+
+/* step through a whole day, one frame at a time */
+static void test_index(const struct rate *r) {
+	SMPTETimecode st, st2;
+	LTCFrame frame;
+	char str[LTC_TIMECODE_STRING_SIZE], ref[32];
+	long long i = 0;
+
+	memset(&st, 0, sizeof(st));
+	strcpy(st.timezone, "+0000");
+	init_frame(&frame, r, &st);
+
+	do {
+		check(ltc_frame_to_index(&frame, r->fps) == i, "frame to index", r, i);
+		ltc_frame_to_time(&st, &frame, 0);
+		check(ltc_time_to_index(&st, r->fps, r->drop_frame) == i, "time to index", r, i);
+		memcpy(&st2, &st, sizeof(st2));
+		st2.hours = st2.mins = st2.secs = st2.frame = 0xff;
+		ltc_index_to_time(&st2, i, r->fps, r->drop_frame);
+		check(!memcmp(&st, &st2, sizeof(st)), "index to time", r, i);
+
+		check(ltc_frame_to_string(str, &frame) == 11, "frame to string length", r, i);
+		snprintf(ref, sizeof(ref), "%02d:%02d:%02d%c%02d", st.hours, st.mins, st.secs, r->drop_frame ? ';' : ':', st.frame);
+		check(!strcmp(str, ref), "frame to string", r, i);
+		st2.hours = st2.mins = st2.secs = st2.frame = 0xff;
+		check(ltc_time_from_string(&st2, str) == r->drop_frame, "string to time", r, i);
+		check(!memcmp(&st, &st2, sizeof(st)), "string to time", r, i);
+		++i;
+	} while (ltc_frame_increment(&frame, r->fps, r->standard, 0) == 0 && !failed);
+}
+
+/* compare ltc_frame_add() with stepping, across day, month and year boundaries */
+static void test_add(const struct rate *r) {
+	static const long long steps[] = { 1, 2, 17, 1799, 1800, 17982, 86400, 123457 };
+	static const int dates[][3] = { {99, 12, 31}, {3, 2, 28}, {4, 2, 28}, {4, 3, 1}, {0, 1, 1} };
+	unsigned int d, s;
+
+	for (d = 0; d < sizeof(dates) / sizeof(dates[0]); ++d) {
+		for (s = 0; s < sizeof(steps) / sizeof(steps[0]); ++s) {
+			const long long n = steps[s];
+			SMPTETimecode st;
+			LTCFrame a, b;
+			long long k;
+			int dir;
+
+			memset(&st, 0, sizeof(st));
+			strcpy(st.timezone, "+0100");
+			st.years  = dates[d][0];
+			st.months = dates[d][1];
+			st.days   = dates[d][2];
+			st.hours  = d & 1 ? 0 : 23;
+			st.mins   = 59;
+			st.secs   = 30;
+			st.frame  = 3;
+
+			for (dir = 1; dir >= -1; dir -= 2) {
+				init_frame(&a, r, &st);
+				init_frame(&b, r, &st);
+				for (k = 0; k < n; ++k) {
+					if (dir > 0) {
+						ltc_frame_increment(&a, r->fps, r->standard, LTC_USE_DATE);
+					} else {
+						ltc_frame_decrement(&a, r->fps, r->standard, LTC_USE_DATE);
+					}
+				}
+				ltc_frame_add(&b, dir * n, r->fps, r->standard, LTC_USE_DATE);
+				check(!memcmp(&a, &b, sizeof(LTCFrame)), "add", r, dir * n);
+
+				init_frame(&b, r, &st);
+				check(ltc_frame_difference(&b, &a, r->fps, LTC_USE_DATE) == dir * n, "difference", r, dir * n);
+			}
+		}
+	}
+}
+
+static void test_timezones(void) {
+	int code;
+
+	for (code = 0; code < 256; ++code) {
+		SMPTETimecode st;
+		LTCFrame frame;
+
+		ltc_frame_reset(&frame);
+		frame.user1 = 1;
+		frame.user3 = 1;
+		frame.user7 = code & 0x0F;
+		frame.user8 = code >> 4;
+		ltc_frame_to_time(&st, &frame, LTC_USE_DATE);
+
+		if (code != 0 && !strcmp(st.timezone, "+0000")) {
+			/* undefined code */
+			continue;
+		}
+
+		ltc_frame_reset(&frame);
+		ltc_time_to_frame(&frame, &st, LTC_TV_525_60, LTC_USE_DATE);
+		if ((frame.user7 | (frame.user8 << 4)) != code) {
+			fprintf(stderr, "Error: timezone code 0x%02x '%s' maps to 0x%02x\n", code, st.timezone, frame.user7 | (frame.user8 << 4));
+			++failed;
+		}
+	}
+}
+
+/* labels skipped by drop-frame timecode map to frame 2 of the minute */
+static void test_dropped_labels(void) {
+	static const struct rate df = { 30, 1, LTC_TV_525_60 };
+	SMPTETimecode st;
+	int mins, frame;
+
+	memset(&st, 0, sizeof(st));
+	st.secs = 59;
+	st.frame = 29;
+	check(ltc_time_to_index(&st, 30, 1) == 1799, "index of 00:00:59;29", &df, 1799);
+
+	for (mins = 0; mins < 60; ++mins) {
+		const long long first = 1800 * mins - 2 * (mins - mins / 10) + (mins % 10 ? 2 : 0);
+		st.mins = mins;
+		st.secs = 0;
+		for (frame = 0; frame < 3; ++frame) {
+			const long long expect = mins % 10 ? first : first + frame;
+			st.frame = frame;
+			check(ltc_time_to_index(&st, 30, 1) == expect, "index of dropped label", &df, mins * 100 + frame);
+		}
+	}
+}
+
+/* compare the batch conversions with the per-frame functions and with
+ * the BCD fields on random frames, including invalid BCD digits */
+static void test_batch(void) {
+	enum { N = 4096 };
+	static LTCFrame frames[N];
+	static SMPTETimecode st[N];
+	static long long index[N];
+	static const int fps[] = { 0, 24, 25, 30 };
+	unsigned int seed = 1;
+	unsigned int i, f, b;
+	int flags;
+
+	for (i = 0; i < N; ++i) {
+		unsigned char *p = (unsigned char*) &frames[i];
+		for (b = 0; b < sizeof(LTCFrame); ++b) {
+			seed = seed * 1103515245 + 12345;
+			p[b] = seed >> 16;
+		}
+	}
+
+	for (flags = 0; flags <= LTC_USE_DATE; flags += LTC_USE_DATE) {
+		memset(st, 0xff, sizeof(st));
+		ltc_frames_to_time(st, frames, N, flags);
+		for (i = 0; i < N; ++i) {
+			const LTCFrame *fr = &frames[i];
+			SMPTETimecode ref;
+			int ok;
+
+			ltc_frame_to_time(&ref, &frames[i], flags);
+			ok = !memcmp(&st[i], &ref, sizeof(ref))
+				&& st[i].hours == fr->hours_units + fr->hours_tens * 10
+				&& st[i].mins  == fr->mins_units  + fr->mins_tens  * 10
+				&& st[i].secs  == fr->secs_units  + fr->secs_tens  * 10
+				&& st[i].frame == fr->frame_units + fr->frame_tens * 10;
+			if (flags & LTC_USE_DATE) {
+				ok = ok
+					&& st[i].years  == fr->user5 + fr->user6 * 10
+					&& st[i].months == fr->user3 + fr->user4 * 10
+					&& st[i].days   == fr->user1 + fr->user2 * 10;
+			} else {
+				ok = ok && st[i].years == 0 && st[i].months == 0 && st[i].days == 0;
+			}
+			if (!ok) {
+				fprintf(stderr, "Error: frames to time, flags %d, frame %u\n", flags, i);
+				++failed;
+				break;
+			}
+		}
+	}
+
+	for (f = 0; f < sizeof(fps) / sizeof(fps[0]); ++f) {
+		ltc_frames_to_index(index, frames, N, fps[f]);
+		for (i = 0; i < N; ++i) {
+			if (index[i] != ltc_frame_to_index(&frames[i], fps[f])) {
+				fprintf(stderr, "Error: frames to index, %d fps, frame %u\n", fps[f], i);
+				++failed;
+				break;
+			}
+		}
+	}
+}
+
+static void test_strings(void) {
+	static const struct {
+		const char *str;
+		int rv;
+	} tests[] = {
+		{ "00:00:00:00", 0 },
+		{ "23:59:59;29", 1 },
+		{ "12:34:56.07", 1 },
+		{ "01:02:03:04 | 1234", 0 },
+		{ "24:00:00:00", -1 },
+		{ "00:60:00:00", -1 },
+		{ "00:00:60:00", -1 },
+		{ "00:00:00,00", -1 },
+		{ "00-00:00:00", -1 },
+		{ "0:00:00:00", -1 },
+		{ "00:00:00:0", -1 },
+		{ "00:00:00:000", -1 },
+		{ "00:00:00:39", 0 },
+		{ "00:00:00:40", -1 },
+		{ "00:00:00:99", -1 },
+		{ "00:10:00;00", 1 },
+		{ "00:11:00;01", -1 },
+		{ "00:11:00.00", -1 },
+		{ "00:11:00:00", 0 },
+		{ "00:11:01;00", 1 },
+		{ "00:00", -1 },
+		{ "", -1 },
+	};
+	unsigned int t;
+
+	for (t = 0; t < sizeof(tests) / sizeof(tests[0]); ++t) {
+		SMPTETimecode st;
+		char str[LTC_TIMECODE_STRING_SIZE];
+		int rv;
+
+		memset(&st, 0, sizeof(st));
+		rv = ltc_time_from_string(&st, tests[t].str);
+		if (rv != tests[t].rv) {
+			fprintf(stderr, "Error: parsing '%s' returned %d, expected %d\n", tests[t].str, rv, tests[t].rv);
+			++failed;
+			continue;
+		}
+		if (rv < 0) {
+			continue;
+		}
+		ltc_time_to_string(str, &st, rv);
+		if (strncmp(str, tests[t].str, 8) || str[8] != (rv ? ';' : ':') || strncmp(str + 9, tests[t].str + 9, 2)) {
+			fprintf(stderr, "Error: '%s' formatted as '%s'\n", tests[t].str, str);
+			++failed;
+		}
+	}
+}
+
+int main(int argc, char **argv) {
+	unsigned int r;
+
+	for (r = 0; r < sizeof(rates) / sizeof(rates[0]); ++r) {
+		test_index(&rates[r]);
+		test_add(&rates[r]);
+	}
+	test_timezones();
+	test_dropped_labels();
+	test_batch();
+	test_strings();
+
+	if (failed) {
+		fprintf(stderr, "%d timecode tests failed.\n", failed);
+		return 1;
+	}
+	return 0;
+}